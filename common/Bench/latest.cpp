@@ -0,0 +1,137 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+/**
+ * @brief Measures the cost of reading an `ipc::Latest` register.
+ *
+ * The register is compared with a value guarded by a lock, as in an
+ * `AsyncValue`, using both the project's `Mutex` and a spinlock. On the host
+ * `ipc::SpinLock` is a mutex, so a bare test-and-set lock stands in for the
+ * STM32 one, without the cost of its critical section. Reads are timed alone
+ * and while another thread writes continuously.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "obc/ipc/latest.hpp"
+#include "obc/ipc/mutex.hpp"
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr std::uint32_t kReads {20'000'000};
+
+/**
+ * @brief A sensor snapshot of typical size.
+ */
+struct Snapshot {
+    std::array<float, 9> axes;
+    std::uint32_t         timestamp;
+};
+
+/**
+ * @brief Stand-in for the STM32 spinlock without its critical section.
+ */
+class TestAndSetLock {
+  public:
+    auto lock() -> void {
+        while (m_flag.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    auto unlock() -> void { m_flag.clear(std::memory_order_release); }
+
+  private:
+    std::atomic_flag m_flag {};
+};
+
+/**
+ * @brief A value copied in and out under a lock.
+ */
+template<typename L>
+class Locked {
+  public:
+    auto Write(const Snapshot& value) -> void {
+        std::scoped_lock lock(m_lock);
+        m_value = value;
+    }
+
+    auto Read() -> Snapshot {
+        std::scoped_lock lock(m_lock);
+        return m_value;
+    }
+
+  private:
+    L        m_lock {};
+    Snapshot m_value {};
+};
+
+/**
+ * @brief Reads the register repeatedly, with or without a concurrent writer,
+ * and reports the time per read.
+ */
+template<typename R>
+auto Measure(const char* name, R& reg, bool contended) -> void {
+    std::atomic<bool> done {false};
+    std::thread       writer {};
+    if (contended) {
+        writer = std::thread {[&] {
+            for (std::uint32_t i {0}; !done.load(std::memory_order_relaxed);
+                 ++i) {
+                reg.Write(Snapshot {.axes = {}, .timestamp = i});
+                if (i % 256 == 0) std::this_thread::yield();
+            }
+        }};
+    }
+
+    const auto    start {SteadyClock::now()};
+    std::uint64_t sum {0};
+    for (std::uint32_t i {0}; i < kReads; ++i) sum += reg.Read().timestamp;
+    const std::chrono::duration<double> elapsed {SteadyClock::now() - start};
+
+    done = true;
+    if (writer.joinable()) writer.join();
+    std::printf(
+        "%-10s %-12s %6.1f ns/read  (checksum %llu)\n", name,
+        contended ? "with writer" : "alone", elapsed.count() * 1e9 / kReads,
+        static_cast<unsigned long long>(sum)
+    );
+}
+
+template<typename R>
+auto MeasureBoth(const char* name) -> void {
+    R reg {};
+    Measure(name, reg, false);
+    Measure(name, reg, true);
+}
+}  // namespace
+
+auto main() -> int {
+    MeasureBoth<Locked<obc::ipc::Mutex>>("mutex");
+    MeasureBoth<Locked<TestAndSetLock>>("spinlock");
+    MeasureBoth<obc::ipc::Latest<Snapshot>>("latest");
+    return 0;
+}
@@ -0,0 +1,126 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+/**
+ * @brief Measures the throughput of `ipc::MpmcQueue` as producers are added.
+ *
+ * From 1 to 8 producer threads feed a single consumer, as tasks feed a
+ * logging task, and each count is compared with a queue guarded by an
+ * `ipc::Mutex`. Threads yield whenever the queue is full or empty.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/ipc/queue.hpp"
+
+namespace {
+using obc::ipc::MpmcQueue;
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr std::uint64_t kElements {4'000'000};
+constexpr std::size_t   kCapacity {256};
+constexpr std::size_t   kMaxProducers {8};
+
+/**
+ * @brief The alternative available before, every operation takes the lock.
+ */
+class LockedQueue {
+  public:
+    auto TryPush(std::uint64_t value) -> bool {
+        std::scoped_lock lock(m_lock);
+        if (m_size == kCapacity) return false;
+        m_elements.at((m_head + m_size++) % kCapacity) = value;
+        return true;
+    }
+
+    auto TryPop() -> std::optional<std::uint64_t> {
+        std::scoped_lock lock(m_lock);
+        if (m_size == 0) return std::nullopt;
+        const auto value {m_elements.at(m_head)};
+        m_head = (m_head + 1) % kCapacity;
+        --m_size;
+        return value;
+    }
+
+  private:
+    obc::ipc::Mutex                      m_lock {};
+    std::array<std::uint64_t, kCapacity> m_elements {};
+    std::size_t                          m_head {0};
+    std::size_t                          m_size {0};
+};
+
+/**
+ * @brief Moves every element through a queue and gets the rate.
+ *
+ * @return Elements transferred per second, or zero if any were lost.
+ */
+template<typename Queue>
+auto Measure(std::size_t producers) -> double {
+    Queue      queue {};
+    const auto share {kElements / producers};
+    const auto total {share * producers};
+
+    const auto               start {SteadyClock::now()};
+    std::vector<std::thread> threads {};
+    for (std::size_t p {0}; p < producers; ++p) {
+        threads.emplace_back([&queue, share, p] {
+            for (auto i {p * share}; i < (p + 1) * share; ++i)
+                while (!queue.TryPush(i)) std::this_thread::yield();
+        });
+    }
+
+    std::uint64_t sum {0};
+    for (std::uint64_t received {0}; received < total;) {
+        if (auto value {queue.TryPop()}) {
+            sum += *value;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) thread.join();
+
+    const std::chrono::duration<double> elapsed {SteadyClock::now() - start};
+    if (sum != total * (total - 1) / 2) return 0;
+    return static_cast<double>(total) / elapsed.count();
+}
+}  // namespace
+
+auto main() -> int {
+    std::printf("%-9s %14s %14s\n", "producers", "mpmc ops/s", "locked ops/s");
+    for (std::size_t producers {1}; producers <= kMaxProducers; ++producers) {
+        std::printf(
+            "%-9zu %14.0f %14.0f\n", producers,
+            Measure<MpmcQueue<std::uint64_t, kCapacity>>(producers),
+            Measure<LockedQueue>(producers)
+        );
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+/**
+ * @brief Measures the throughput of `ipc::SpscRing` between two threads.
+ *
+ * The ring is compared with a queue which, like a FreeRTOS `xQueue`, copies
+ * each element in and out under a lock. Elements are moved one at a time and
+ * in bulk, with the consumer yielding whenever it finds nothing to take.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/ipc/ring.hpp"
+
+namespace {
+using obc::ipc::StaticSpscRing;
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr std::uint32_t kElements {10'000'000};
+constexpr std::size_t   kCapacity {256};
+constexpr std::size_t   kChunk {32};
+
+/**
+ * @brief Stand-in for a FreeRTOS queue, every operation takes the lock.
+ */
+class LockedQueue {
+  public:
+    auto TryPush(std::uint32_t value) -> bool {
+        std::scoped_lock lock(m_lock);
+        if (m_size == kCapacity) return false;
+        m_elements.at((m_head + m_size++) % kCapacity) = value;
+        return true;
+    }
+
+    auto TryPop() -> std::optional<std::uint32_t> {
+        std::scoped_lock lock(m_lock);
+        if (m_size == 0) return std::nullopt;
+        const auto value {m_elements.at(m_head)};
+        m_head = (m_head + 1) % kCapacity;
+        --m_size;
+        return value;
+    }
+
+  private:
+    obc::ipc::Mutex                      m_lock {};
+    std::array<std::uint32_t, kCapacity> m_elements {};
+    std::size_t                          m_head {0};
+    std::size_t                          m_size {0};
+};
+
+/**
+ * @brief Runs a producer and consumer to completion and reports the rate.
+ */
+template<typename Produce, typename Consume>
+auto Measure(const char* name, Produce produce, Consume consume) -> void {
+    const auto start {SteadyClock::now()};
+    std::thread producer {produce};
+    const auto  checksum {consume()};
+    producer.join();
+    const std::chrono::duration<double> elapsed {SteadyClock::now() - start};
+
+    const auto expected {
+        static_cast<std::uint64_t>(kElements) * (kElements - 1) / 2
+    };
+    std::printf(
+        "%-12s %8.2f Mitems/s  %6.1f ns/item%s\n", name,
+        kElements / elapsed.count() / 1e6, elapsed.count() * 1e9 / kElements,
+        checksum == expected ? "" : "  (corrupted)"
+    );
+}
+
+template<typename Queue>
+auto Single(const char* name, Queue& queue) -> void {
+    Measure(
+        name,
+        [&] {
+            for (std::uint32_t i {0}; i < kElements; ++i)
+                while (!queue.TryPush(i)) std::this_thread::yield();
+        },
+        [&] {
+            std::uint64_t sum {0};
+            for (std::uint32_t received {0}; received < kElements;) {
+                if (auto value {queue.TryPop()}) {
+                    sum += *value;
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            return sum;
+        }
+    );
+}
+
+auto Bulk(const char* name, StaticSpscRing<std::uint32_t, kCapacity>& ring)
+    -> void {
+    Measure(
+        name,
+        [&] {
+            std::array<std::uint32_t, kChunk> chunk {};
+            for (std::uint32_t next {0}; next < kElements;) {
+                const auto size {
+                    std::min<std::size_t>(kChunk, kElements - next)
+                };
+                for (std::size_t i {0}; i < size; ++i)
+                    chunk.at(i) = next + static_cast<std::uint32_t>(i);
+
+                const auto pushed {ring.Push(std::span(chunk).first(size))};
+                if (!pushed) std::this_thread::yield();
+                next += static_cast<std::uint32_t>(pushed);
+            }
+        },
+        [&] {
+            std::array<std::uint32_t, kChunk> chunk {};
+            std::uint64_t                     sum {0};
+            for (std::uint32_t received {0}; received < kElements;) {
+                const auto popped {ring.Pop(chunk)};
+                if (!popped) std::this_thread::yield();
+                for (std::size_t i {0}; i < popped; ++i) sum += chunk.at(i);
+                received += static_cast<std::uint32_t>(popped);
+            }
+            return sum;
+        }
+    );
+}
+}  // namespace
+
+auto main() -> int {
+    LockedQueue locked {};
+    Single("locked", locked);
+
+    StaticSpscRing<std::uint32_t, kCapacity> ring {};
+    Single("spsc", ring);
+    Bulk("spsc bulk", ring);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+/**
+ * @brief Measures how quickly the simulated hosted backend runs a flight.
+ *
+ * A six hour flight of a representative task set is simulated twice. The wall
+ * time, the number of events processed and a hash of the trace of every run
+ * are reported, so that speed and reproducibility can be checked at a glance.
+ * The stack usage of each task and its recommended depth are reported too.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+#include <units/time.h>
+
+#include "obc/scheduling/delay.hpp"
+#include "obc/scheduling/simulation.hpp"
+#include "obc/scheduling/task.hpp"
+
+namespace {
+using obc::scheduling::Clock;
+using obc::scheduling::Simulation;
+using obc::scheduling::StackTask;
+using obc::scheduling::StackUsage;
+using obc::scheduling::Task;
+using obc::scheduling::Timeout;
+using obc::scheduling::WakeReason;
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr Clock::Instant kFlight {6ULL * 60 * 60 * 1'000'000};
+
+/**
+ * @brief Folds the time and identity of each run into a shared hash.
+ */
+class Job : public StackTask<256> {
+  public:
+    Job(const char* name, std::uint64_t& hash, std::uint64_t id,
+        float period_ms, float busy_us, osPriority priority)
+        : StackTask(name, units::milliseconds<float>(period_ms), priority),
+          m_hash(hash), m_id(id), m_busy(busy_us) {}
+
+    ~Job() override = default;
+
+    Job(const Job&)                    = delete;
+    Job(Job&&)                         = delete;
+    auto operator=(const Job&) -> Job& = delete;
+    auto operator=(Job&&) -> Job&      = delete;
+
+    /// Task notified on every run, if any.
+    obc::scheduling::Task* notify {nullptr};
+
+  protected:
+    auto Run(WakeReason reason) -> void override {
+        // FNV-1a over the run time, task and wake reason
+        for (const auto word : {Clock::Now(), m_id,
+                                static_cast<std::uint64_t>(reason)}) {
+            m_hash ^= word;
+            m_hash *= 0x100000001b3ULL;
+        }
+
+        if (m_busy.value() > 0) Timeout(m_busy).Block();
+        if (notify) notify->Notify();
+    }
+
+  private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    std::uint64_t&             m_hash;
+    std::uint64_t              m_id;
+    units::microseconds<float> m_busy;
+};
+
+auto PrintStackReport() -> void {
+    std::array<StackUsage, 8> usages {};
+    const auto count {std::min(Task::StackReport(usages), usages.size())};
+
+    std::printf("%-12s %8s %8s %12s\n", "task", "depth", "peak", "recommended");
+    for (const auto& usage : std::span(usages).first(count)) {
+        std::printf(
+            "%-12s %8zu %8zu %12zu\n", usage.name, usage.depth, usage.peak,
+            usage.recommended
+        );
+    }
+}
+
+auto Flight(bool report) -> void {
+    std::uint64_t hash {0xcbf29ce484222325ULL};
+    const auto    start {SteadyClock::now()};
+
+    std::uint64_t events {0};
+    {
+        Simulation sim {};
+        Job        can("CAN", hash, 0, 50, 200, osPriorityHigh);
+        Job        telemetry("Telemetry", hash, 1, 100, 1500, osPriorityNormal);
+        Job        logging("Logging", hash, 2, 1000, 5000, osPriorityLow);
+        can.notify = &logging;
+
+        sim.RunUntil(kFlight);
+        events = sim.Events();
+        if (report) PrintStackReport();
+    }
+
+    const std::chrono::duration<double> wall {SteadyClock::now() - start};
+    std::printf(
+        "6h flight: %llu events in %.2f s (%.0fx real time), trace %016llx\n",
+        static_cast<unsigned long long>(events), wall.count(),
+        static_cast<double>(kFlight) / 1e6 / wall.count(),
+        static_cast<unsigned long long>(hash)
+    );
+}
+}  // namespace
+
+auto main() -> int {
+    Flight(true);
+    Flight(false);
+    return 0;
+}
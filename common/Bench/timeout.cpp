@@ -0,0 +1,121 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+/**
+ * @brief Measures the accuracy of the hosted timeout backend.
+ *
+ * Two cases are measured for a range of periods:
+ *  - One-shot: how far past the requested period `Timeout::Block` returns.
+ *  - Periodic: how late each release of an absolute schedule (as followed by
+ *    periodic tasks) is woken, which is the jitter seen by task code.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+#include <units/time.h>
+
+#include "obc/scheduling/delay.hpp"
+
+namespace {
+using obc::scheduling::Clock;
+using obc::scheduling::Timeout;
+using SteadyClock = std::chrono::steady_clock;
+
+struct Case {
+    std::uint64_t period_us;
+    std::size_t   iterations;
+};
+
+constexpr Case kCases[] {
+    {   20, 2000},
+    {  200, 2000},
+    { 1000, 1000},
+    {10000,  200},
+};
+
+auto Report(const char* name, const Case& c, std::vector<std::int64_t>& errors)
+    -> void {
+    std::ranges::sort(errors);
+    const auto mean {
+        static_cast<double>(std::accumulate(errors.begin(), errors.end(), 0LL)
+        ) /
+        static_cast<double>(errors.size())
+    };
+    const auto p99 {errors[errors.size() * 99 / 100]};
+    std::printf(
+        "%-9s %6llu us  n=%-5zu min %6lld ns  mean %9.0f ns  p99 %6lld ns  max "
+        "%6lld ns\n",
+        name, static_cast<unsigned long long>(c.period_us), errors.size(),
+        static_cast<long long>(errors.front()), mean,
+        static_cast<long long>(p99), static_cast<long long>(errors.back())
+    );
+}
+
+auto OneShot(const Case& c) -> void {
+    std::vector<std::int64_t> overshoot {};
+    overshoot.reserve(c.iterations);
+
+    for (std::size_t i {0}; i < c.iterations; ++i) {
+        const auto start {SteadyClock::now()};
+        Timeout(units::microseconds<float>(static_cast<float>(c.period_us)))
+            .Block();
+        const auto elapsed {SteadyClock::now() - start};
+        overshoot.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                elapsed - std::chrono::microseconds(c.period_us)
+            )
+                .count()
+        );
+    }
+
+    Report("one-shot", c, overshoot);
+}
+
+auto Periodic(const Case& c) -> void {
+    std::vector<std::int64_t> lateness {};
+    lateness.reserve(c.iterations);
+
+    auto release {Clock::Now()};
+    for (std::size_t i {0}; i < c.iterations; ++i) {
+        release += c.period_us;
+        Timeout::Until(release).Block();
+        const auto woken {SteadyClock::now()};
+        lateness.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                woken.time_since_epoch() - std::chrono::microseconds(release)
+            )
+                .count()
+        );
+    }
+
+    Report("periodic", c, lateness);
+}
+}  // namespace
+
+auto main() -> int {
+    for (const auto& c : kCases) OneShot(c);
+    for (const auto& c : kCases) Periodic(c);
+    return 0;
+}
@@ -0,0 +1,252 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <span>
+#include <utility>
+#include <variant>
+
+#include "obc/bus/types.hpp"
+#include "obc/ipc/callback.hpp"
+#include "obc/scheduling/coroutine.hpp"
+
+/**
+ * @brief Awaitables which let coroutines wait for bus events.
+ *
+ * Bus callbacks are invoked from the context of the bus (typically its own
+ * task), so the awaiters record the event and wake the executor rather than
+ * resuming the coroutine directly.
+ */
+namespace obc::bus {
+/**
+ * @brief A message copied out of the bus' buffers.
+ *
+ * The data of a received \ref BasicMessage is only valid for the duration of
+ * the listen callback, so must be copied before a coroutine can use it.
+ *
+ * @tparam N Maximum payload size, longer payloads are truncated.
+ */
+template<std::size_t N>
+struct ReceivedMessage {
+    BasicMessage::Address    address {};
+    std::array<std::byte, N> payload {};
+    std::size_t              size {0};
+
+    /**
+     * @brief Gets the message as a \ref BasicMessage referencing the payload.
+     *
+     * @return The message, valid for the lifetime of this object.
+     */
+    auto View() -> BasicMessage { return {address, {payload.data(), size}}; }
+};
+
+/**
+ * @brief Awaitable which suspends a coroutine until the next message is
+ * received by a bus.
+ *
+ * The listener is only registered while the coroutine is suspended.
+ *
+ * @tparam T Type of the bus.
+ * @tparam N Maximum payload size.
+ */
+template<ListenBus T, std::size_t N>
+class ListenAwaiter : scheduling::internal::Waiter {
+    using Error = T::ListenCallbackError;
+
+    // A failure to listen would have no way to reach the coroutine
+    static_assert(
+        std::same_as<typename T::ListenDispatchError, utils::Never>,
+        "Only buses which always accept listeners can be awaited"
+    );
+
+  public:
+    explicit ListenAwaiter(T& bus) : m_bus(bus) {
+        ready = [](scheduling::internal::Waiter& self) {
+            return static_cast<ListenAwaiter&>(self).m_received.load(
+                std::memory_order_acquire
+            );
+        };
+    }
+
+    auto await_ready() -> bool { return false; }
+
+    auto await_suspend(scheduling::Coroutine::Handle h) -> void {
+        handle     = h;
+        m_executor = &h.Owner();
+        m_handle.emplace(*m_bus.Listen(OBC_CALLBACK_METHOD(*this, OnMessage)));
+        m_executor->Park(*this);
+    }
+
+    auto await_resume() -> std::expected<ReceivedMessage<N>, Error> {
+        m_handle.reset();
+        return std::move(m_message);
+    }
+
+  private:
+    auto OnMessage(const std::expected<BasicMessage, Error>& msg) -> void {
+        // Only the first message is kept, the coroutine has not yet run
+        if (m_received.load(std::memory_order_relaxed)) return;
+
+        if constexpr (!std::same_as<Error, utils::Never>) {
+            if (!msg) {
+                m_message = std::unexpected {msg.error()};
+                m_received.store(true, std::memory_order_release);
+                m_executor->Wake();
+                return;
+            }
+        }
+
+        auto& copy {*m_message};
+        copy.address = msg->address;
+        copy.size    = std::min(msg->data.size(), N);
+        std::copy_n(msg->data.begin(), copy.size, copy.payload.begin());
+
+        m_received.store(true, std::memory_order_release);
+        m_executor->Wake();
+    }
+
+    T&                                       m_bus;
+    scheduling::Executor*                    m_executor {nullptr};
+    std::optional<typename T::ListenHandle>  m_handle {};
+    std::expected<ReceivedMessage<N>, Error> m_message {};
+    std::atomic<bool>                        m_received {false};
+};
+
+/**
+ * @brief Awaitable which sends a message and suspends a coroutine until the
+ * send has completed.
+ *
+ * @tparam T Type of the bus.
+ */
+template<SendBus T>
+class SendAwaiter : scheduling::internal::Waiter {
+  public:
+    /// Why the send failed, when dispatched (0) or when it completed (1).
+    using Error = std::variant<
+        typename T::SendDispatchError, typename T::SendCallbackError>;
+    using Result = std::expected<std::monostate, Error>;
+
+    SendAwaiter(T& bus, BasicMessage msg) : m_bus(bus), m_msg(msg) {
+        ready = [](scheduling::internal::Waiter& self) {
+            return static_cast<SendAwaiter&>(self).m_sent.load(
+                std::memory_order_acquire
+            );
+        };
+    }
+
+    auto await_ready() -> bool { return false; }
+
+    /**
+     * @return False (resuming immediately) if the send failed to dispatch or
+     * completed synchronously.
+     */
+    auto await_suspend(scheduling::Coroutine::Handle h) -> bool {
+        handle     = h;
+        m_executor = &h.Owner();
+
+        auto res {m_bus.Send(m_msg, OBC_CALLBACK_METHOD(*this, OnSent))};
+        if constexpr (!std::same_as<
+                          typename T::SendDispatchError, utils::Never>) {
+            if (!res) {
+                m_result = std::unexpected {
+                    Error {std::in_place_index<0>, std::move(res.error())}
+                };
+                return false;
+            }
+        }
+
+        m_handle.emplace(std::move(*res));
+        if (m_sent.load(std::memory_order_acquire)) return false;
+
+        m_executor->Park(*this);
+        return true;
+    }
+
+    auto await_resume() -> Result {
+        m_handle.reset();
+        return std::move(m_result);
+    }
+
+  private:
+    auto OnSent(
+        const std::expected<BasicMessage, typename T::SendCallbackError>& msg
+    ) -> void {
+        if constexpr (!std::same_as<
+                          typename T::SendCallbackError, utils::Never>) {
+            if (!msg) {
+                m_result = std::unexpected {
+                    Error {std::in_place_index<1>, msg.error()}
+                };
+            }
+        }
+
+        m_sent.store(true, std::memory_order_release);
+        // A spurious wake is harmless if the send completed synchronously
+        m_executor->Wake();
+    }
+
+    T&                                    m_bus;
+    BasicMessage                          m_msg;
+    scheduling::Executor*                 m_executor {nullptr};
+    std::optional<typename T::SendHandle> m_handle {};
+    Result                                m_result {};
+    std::atomic<bool>                     m_sent {false};
+};
+
+/**
+ * @brief Waits for the next message received by a bus.
+ *
+ * @code
+ * auto msg {co_await bus::NextMessage<8>(can)};
+ * @endcode
+ *
+ * @tparam N Maximum payload size to keep.
+ * @param bus The bus to listen on.
+ *
+ * @return An awaitable resolving to the received message.
+ */
+template<std::size_t N, ListenBus T>
+auto NextMessage(T& bus) -> ListenAwaiter<T, N> {
+    return ListenAwaiter<T, N>(bus);
+}
+
+/**
+ * @brief Sends a message and waits for the send to complete.
+ *
+ * @param bus The bus to send on.
+ * @param msg The message to send, whose data must remain valid until
+ * completion.
+ *
+ * @return An awaitable resolving to whether the send was dispatched.
+ */
+template<SendBus T>
+auto SendAndWait(T& bus, BasicMessage msg) -> SendAwaiter<T> {
+    return SendAwaiter<T>(bus, msg);
+}
+}  // namespace obc::bus
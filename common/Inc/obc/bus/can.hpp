@@ -21,6 +21,7 @@
 #define FDCAN1
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <optional>
 #include <span>
@@ -37,11 +38,15 @@
 
 namespace obc::bus {
 /**
- * To prevent this driver from locking up the entire system in an ISR, the
- * implementation elects to use a polling approach.
+ * To prevent this driver from locking up the entire system in an ISR, received
+ * frames are processed in the driver's task.
  *
- * todo(evan): The more efficient approach would be to register an interupt
- * which sets the ready flag on this task. This avoids excessive polling.
+ * The FIFOs are polled each period, the FDCAN RX interrupt should call
+ * `NotifyFromIsr` so that frames are processed as soon as they arrive rather
+ * than waiting for the next poll.
+ *
+ * Senders block while the TX FIFO is full, the FDCAN TX complete interrupt
+ * should call `TxFreedFromIsr` to wake them.
  */
 class CanFd : public scheduling::StackTask<>, bus::ListenBusMixin<> {
   public:
@@ -64,12 +69,15 @@ class CanFd : public scheduling::StackTask<>, bus::ListenBusMixin<> {
         std::lock_guard lock {m_send_lock};
 
         // Wait for a free slot in the message queue
-        // TODO(evan): Don't busy wait here
+        auto waiter {scheduling::Notification::Current()};
+        m_tx_waiter.store(&waiter, std::memory_order_release);
         scheduling::Timeout timeout_block(units::milliseconds<float>(100));
-        if (!timeout_block.Poll([&]() {
-                return HAL_FDCAN_GetTxFifoFreeLevel(m_handle);
-            }))
-            return std::unexpected {SendDispatchError::kTimeout};
+        const bool          freed {timeout_block.Poll(
+            [&]() { return HAL_FDCAN_GetTxFifoFreeLevel(m_handle); },
+            scheduling::wait::Notify {}
+        )};
+        m_tx_waiter.store(nullptr, std::memory_order_release);
+        if (!freed) return std::unexpected {SendDispatchError::kTimeout};
 
         // Pad the payload so that it fits within a valid DLC size if required
         auto [dlc, padding] {UNWRAP_TAGGED(
@@ -112,8 +120,18 @@ class CanFd : public scheduling::StackTask<>, bus::ListenBusMixin<> {
         return {};
     }
 
+    /**
+     * @brief Wakes the sender waiting for a free slot in the TX FIFO, if any.
+     *
+     * Must be called from the FDCAN TX complete interrupt.
+     */
+    inline auto TxFreedFromIsr() -> void {
+        if (auto* waiter {m_tx_waiter.load(std::memory_order_acquire)})
+            waiter->GiveFromIsr();
+    }
+
   protected:
-    inline auto Run() -> void override {
+    inline auto Run(scheduling::WakeReason /*reason*/) -> void override {
         for (const auto& fifo : {FDCAN_RX_FIFO0, FDCAN_RX_FIFO1}) {
             // Does this FIFO have any incoming messages?
             if (!HAL_FDCAN_GetRxFifoFillLevel(m_handle, fifo)) continue;
@@ -178,6 +196,8 @@ class CanFd : public scheduling::StackTask<>, bus::ListenBusMixin<> {
 
     FDCAN_HandleTypeDef* m_handle;
     ipc::Mutex           m_send_lock {};
+    // Sender waiting for space in the TX FIFO, guarded by m_send_lock
+    std::atomic<scheduling::Notification*> m_tx_waiter {nullptr};
 };
 
 static_assert(SendBus<CanFd>);
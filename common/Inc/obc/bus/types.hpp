@@ -119,11 +119,14 @@ concept MessageCallback = requires(T& cb, const std::expected<M, E>& msg) {
     { cb(msg) } -> std::convertible_to<R>;
 } && HandleLike<T> && utils::MaybeError<E> && Message<M>;
 
+/**
+ * @brief Stands for a callback provider in the requirements of bus concepts.
+ *
+ * Only declared, like `std::declval`, as it is never evaluated.
+ */
 template<typename R, typename E, typename M>
-auto MessageCallbackProvider() {
-    return std::declval<
-        ipc::Callback<R, const std::expected<M, E>&>::DummyProvider>();
-}
+auto MessageCallbackProvider() ->
+    typename ipc::Callback<R, const std::expected<M, E>&>::DummyProvider;
 
 /**
  * @brief Represents a bus that can send packets of data to an address.
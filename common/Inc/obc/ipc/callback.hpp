@@ -35,26 +35,80 @@ namespace obc::ipc {
 /**
  * @brief Wrapper type for data which can be asynchronously set.
  *
- * Polling operation can be performed to check/wait for the value.
+ * The value can be polled, or a task can block in \ref Wait until it is set.
+ * A blocked task sleeps on its wait notification (see
+ * \ref scheduling::Notification::Current), which \ref Set gives, so no CPU
+ * time is spent while waiting and the task's loop is not woken.
  *
  * @tparam T Type of wrapped value.
- * @tparam L Lock to use for thread safety.
+ * @tparam L Lock to use for thread safety, which must be safe in interrupts
+ * for \ref Set to be.
  */
-template<typename T, typename L = SpinLock>
+template<typename T, typename L = IsrLock>
 class AsyncValue {
   public:
     AsyncValue() = default;
 
     /**
-     * @brief Assign a result.
+     * @brief Assign a result, waking the task waiting for it.
+     *
+     * Safe to call from interrupts.
      *
      * @param data Value to set.
      *
      * @warning It is undefined behaviour to assign to an async value twice
      */
     auto Set(const T& data) -> void {
+        std::optional<scheduling::Notification> waiter {};
+        {
+            std::scoped_lock lock(m_lock);
+            if (m_data) return;
+            m_data = data;
+            waiter.swap(m_waiter);
+        }
+
+        if (waiter) waiter->GiveFromAny();
+    }
+
+    /**
+     * @brief Blocks the calling task until a value is set.
+     *
+     * Only one task may wait at a time.
+     *
+     * @param timeout Longest time to wait.
+     *
+     * @return std::nullopt if no value was set in time, otherwise a reference
+     * to the value.
+     */
+    auto Wait(scheduling::Duration timeout)
+        -> std::optional<std::reference_wrapper<T>> {
+        scheduling::Timeout deadline {timeout};
+        Subscribe(scheduling::Notification::Current());
+        auto result {deadline.Poll(*this, scheduling::wait::Notify {})};
+        Unsubscribe();
+        return result;
+    }
+
+    /**
+     * @brief Registers a notification to be given when the value is set.
+     *
+     * Replaces any notification registered before. Used by \ref Wait and
+     * \ref WaitAny, which check the value only after registering so that a
+     * concurrent \ref Set is never missed.
+     *
+     * @param waiter The notification.
+     */
+    auto Subscribe(scheduling::Notification waiter) -> void {
+        std::scoped_lock lock(m_lock);
+        m_waiter.emplace(waiter);
+    }
+
+    /**
+     * @brief Removes the registered notification.
+     */
+    auto Unsubscribe() -> void {
         std::scoped_lock lock(m_lock);
-        if (!m_data) m_data = data;
+        m_waiter.reset();
     }
 
     /**
@@ -66,12 +120,14 @@ class AsyncValue {
     auto operator()() -> std::optional<std::reference_wrapper<T>> {
         // Returning a reference to the underlying option would be unsafe
         std::scoped_lock lock(m_lock);
-        return m_data ? std::optional(m_data.value()) : std::nullopt;
+        return m_data ? std::optional(std::ref(*m_data)) : std::nullopt;
     }
 
   private:
-    std::optional<T> m_data {};
-    L                m_lock {};
+    std::optional<T>                        m_data {};
+    // Notification of the task waiting for the value, if any
+    std::optional<scheduling::Notification> m_waiter {};
+    L                                       m_lock {};
 };
 
 /**
@@ -296,11 +352,22 @@ class Callback {
 template<typename T, typename R, typename... As>
 concept CallbackSource = std::convertible_to<T, Callback<R, As...>>;
 
+/**
+ * @brief Starts an asynchronous operation and blocks until it completes.
+ *
+ * @param f Function starting the operation, given the value to set on
+ * completion followed by args.
+ * @param timeout Longest time to wait for completion.
+ * @param args Additional arguments to f.
+ *
+ * @return The result, or std::nullopt if the operation did not complete in
+ * time.
+ */
 template<typename T, typename F, typename... As>
-auto Await(F f, units::milliseconds<float> timeout, As... args)
+auto Await(F f, scheduling::Duration timeout, As... args)
     -> std::optional<T> {
     AsyncValue<T> res {};
     f(res, args...);
-    return obc::scheduling::Timeout(timeout).Poll(res);
+    return res.Wait(timeout);
 }
 }  // namespace obc::ipc
@@ -0,0 +1,268 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include "obc/ipc/doorbell.hpp"
+#include "obc/ipc/ring.hpp"
+#include "obc/scheduling/delay.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+/**
+ * @brief Places an object in the memory shared by the cores.
+ *
+ * On the STM32 this is the `.shared` section, which the linker scripts of both
+ * images place at the same address in D2 SRAM3, and which must be
+ * non-cacheable for the CM7. Both images must define the same shared objects
+ * in the same order. The section is neither loaded nor zeroed at startup, so
+ * objects in it must be constant-initialised and then reset at runtime by one
+ * core before the other core uses them.
+ */
+#ifdef BALLOON_STM32
+#    define OBC_SHARED __attribute__((section(".shared")))
+#else
+#    define OBC_SHARED
+#endif
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+namespace obc::ipc {
+/**
+ * @brief A zero-copy channel for passing messages from one core to the other.
+ *
+ * The channel is a ring of message slots which lives in memory shared by the
+ * cores. The producer reserves the next free slot, fills it in place and
+ * commits it, and the consumer reads the oldest slot in place before
+ * releasing it back to the producer. So a message is written once into shared
+ * memory and never copied, unlike passing it through a mutex-protected buffer.
+ *
+ * Each side only writes its own index, with release and acquire ordering, so
+ * neither side takes a lock. A side which waits raises a flag in the channel
+ * and listens for a \ref Doorbell, which the other side rings only when the
+ * flag is raised, so messages cost no interrupts while both sides keep up.
+ *
+ * @code
+ * // Shared header
+ * OBC_SHARED constinit CoreChannel<ImuSample, 16> g_imu {};
+ *
+ * // CM7, before releasing the CM4 from boot
+ * g_imu.Reset(Doorbell(1), Doorbell(2));
+ *
+ * // CM4 acquisition task
+ * if (auto* sample {g_imu.TryReserve()}) {
+ *     ReadInto(*sample);
+ *     g_imu.Commit();
+ * }
+ *
+ * // CM7 processing task
+ * if (const auto* sample {g_imu.Peek(units::milliseconds<float>(10))}) {
+ *     Fuse(*sample);
+ *     g_imu.Release();
+ * }
+ * @endcode
+ *
+ * @warning There must be one producer and one consumer, and each must finish
+ * with a slot before reserving or peeking another.
+ *
+ * @tparam T Type of message, which must have the same layout on both cores.
+ * @tparam Capacity Number of slots, a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class CoreChannel {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(
+        Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two"
+    );
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+  public:
+    /// Number of messages the channel can hold.
+    static constexpr std::size_t kCapacity = Capacity;
+
+    constexpr CoreChannel()                            = default;
+    CoreChannel(const CoreChannel&)                    = delete;
+    CoreChannel(CoreChannel&&)                         = delete;
+    auto operator=(const CoreChannel&) -> CoreChannel& = delete;
+    auto operator=(CoreChannel&&) -> CoreChannel&      = delete;
+    ~CoreChannel()                                     = default;
+
+    /**
+     * @brief Empties the channel and sets the doorbells used to wake each
+     * side.
+     *
+     * Must be called by one core while the other is not yet using the
+     * channel.
+     *
+     * @param filled Rung by the producer to wake the consumer.
+     * @param drained Rung by the consumer to wake the producer.
+     */
+    auto Reset(Doorbell filled, Doorbell drained) -> void {
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_consumer_waiting.store(0, std::memory_order_relaxed);
+        m_producer_waiting.store(0, std::memory_order_relaxed);
+        m_filled  = filled;
+        m_drained = drained;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Reserves the next free slot, producer only.
+     *
+     * @return The slot to write the message into, or nullptr if the channel
+     * is full.
+     */
+    auto TryReserve() -> T* {
+        const auto tail {m_tail.load(std::memory_order_relaxed)};
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return nullptr;
+        return &m_slots[tail & kMask];
+    }
+
+    /**
+     * @brief Reserves the next free slot, waiting for the consumer to release
+     * one if the channel is full, producer only.
+     *
+     * @param timeout Longest time to wait.
+     *
+     * @return The slot, or nullptr if the channel stayed full.
+     */
+    auto Reserve(scheduling::Duration timeout) -> T* {
+        if (auto* slot {TryReserve()}) return slot;
+        return Wait(m_producer_waiting, m_drained, timeout, [&] {
+            return TryReserve();
+        });
+    }
+
+    /**
+     * @brief Passes the reserved slot to the consumer, producer only.
+     */
+    auto Commit() -> void {
+        m_tail.fetch_add(1, std::memory_order_release);
+        Wake(m_consumer_waiting, m_filled);
+    }
+
+    /**
+     * @brief Gets the oldest message without removing it, consumer only.
+     *
+     * @return The message, or nullptr if the channel is empty.
+     */
+    auto TryPeek() -> const T* {
+        const auto head {m_head.load(std::memory_order_relaxed)};
+        if (head == m_tail.load(std::memory_order_acquire)) return nullptr;
+        return &m_slots[head & kMask];
+    }
+
+    /**
+     * @brief Gets the oldest message, waiting for one if the channel is
+     * empty, consumer only.
+     *
+     * @param timeout Longest time to wait.
+     *
+     * @return The message, or nullptr if none arrived in time.
+     */
+    auto Peek(scheduling::Duration timeout) -> const T* {
+        if (const auto* slot {TryPeek()}) return slot;
+        return Wait(m_consumer_waiting, m_filled, timeout, [&] {
+            return TryPeek();
+        });
+    }
+
+    /**
+     * @brief Returns the oldest message's slot to the producer, consumer
+     * only.
+     */
+    auto Release() -> void {
+        m_head.fetch_add(1, std::memory_order_release);
+        Wake(m_producer_waiting, m_drained);
+    }
+
+    /**
+     * @brief Gets the number of committed messages not yet released.
+     *
+     * @return The number of messages, only a snapshot while either side is
+     * active.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr std::uint32_t kMask = Capacity - 1;
+
+    /**
+     * @brief Rings a doorbell if the other side is waiting on it.
+     */
+    static auto Wake(std::atomic<std::uint32_t>& waiting, Doorbell bell)
+        -> void {
+        // Pairs with the fence in Wait, ordering the index update before this
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed)) bell.Ring();
+    }
+
+    /**
+     * @brief Polls for a slot, sleeping until the other side rings between
+     * attempts.
+     */
+    template<typename F>
+    static auto Wait(
+        std::atomic<std::uint32_t>& waiting, Doorbell bell,
+        scheduling::Duration timeout, F&& f
+    ) {
+        scheduling::Timeout deadline {timeout};
+        bell.Listen(scheduling::Notification::Current());
+        waiting.store(1, std::memory_order_relaxed);
+        // The next check must not be reordered before the flag is raised, or
+        // the other side could miss it and never ring
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const auto slot {deadline.Poll(
+            [&] -> std::optional<decltype(f())> {
+                if (auto* slot {f()}) return slot;
+                return std::nullopt;
+            },
+            scheduling::wait::Notify {}
+        )};
+        waiting.store(0, std::memory_order_relaxed);
+        bell.Ignore();
+        return slot.value_or(nullptr);
+    }
+
+    // Free-running counts, which wrap cleanly as the capacity divides 2^32
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> m_head {0};
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> m_tail {0};
+    // Raised by a side while it waits for the other to ring its doorbell
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> m_consumer_waiting {0};
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> m_producer_waiting {0};
+    Doorbell m_filled {0};
+    Doorbell m_drained {0};
+    alignas(kCacheLineSize) std::array<T, Capacity> m_slots {};
+};
+}  // namespace obc::ipc
@@ -0,0 +1,227 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include <units/time.h>
+
+#include "obc/ipc/callback.hpp"
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+#include "obc/scheduling/stats.hpp"
+#include "obc/scheduling/task.hpp"
+
+namespace obc::ipc {
+namespace detail {
+/**
+ * @brief Queue and statistics of a \ref DeferredExecutor, a base so that they
+ * exist before its task starts.
+ *
+ * @tparam Capacity Most items which may be queued at once.
+ */
+template<std::size_t Capacity>
+class DeferredQueue {
+  public:
+    /**
+     * @brief A consistent copy of the statistics of an executor.
+     */
+    struct Snapshot {
+        /// Number of items accepted.
+        std::uint32_t                         deferred {0};
+        /// Number of items dropped because the queue was full.
+        std::uint32_t                         overflows {0};
+        /// Most items ever queued at once.
+        std::uint32_t                         high_water {0};
+        /// Execution times and latencies of completed items.
+        scheduling::ExecutionStats::Snapshot latency {};
+    };
+
+    /**
+     * @brief Gets the statistics of the executor.
+     *
+     * @return Statistics accumulated since the executor started.
+     */
+    [[nodiscard]] auto Stats() const -> Snapshot {
+        return {
+            .deferred   = m_deferred.load(std::memory_order_relaxed),
+            .overflows  = m_overflows.load(std::memory_order_relaxed),
+            .high_water = m_high_water.load(std::memory_order_relaxed),
+            .latency    = m_latency.Read(),
+        };
+    }
+
+  protected:
+    /**
+     * @brief Queues work.
+     *
+     * @param work Callback to invoke.
+     *
+     * @return False if the queue was full and the work was dropped.
+     */
+    auto Push(Callback<void> work) -> bool {
+        const auto now {scheduling::Clock::Now()};
+
+        std::scoped_lock lock(m_lock);
+        if (m_count == Capacity) {
+            m_overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_items.at((m_head + m_count) % Capacity).emplace(work, now);
+        ++m_count;
+        m_deferred.fetch_add(1, std::memory_order_relaxed);
+        if (m_count > m_high_water.load(std::memory_order_relaxed))
+            m_high_water.store(m_count, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Runs queued work, in order, until the queue is empty.
+     */
+    auto Drain() -> void {
+        while (const auto item {Pop()}) {
+            const auto start {scheduling::Clock::Now()};
+            auto       work {item->work};
+            work();
+            const auto end {scheduling::Clock::Now()};
+            m_latency.Record(end - start, end - item->deferred, false);
+        }
+    }
+
+  private:
+    struct Item {
+        Callback<void>             work;
+        scheduling::Clock::Instant deferred;
+    };
+
+    auto Pop() -> std::optional<Item> {
+        std::scoped_lock lock(m_lock);
+        if (!m_count) return std::nullopt;
+
+        auto item {m_items.at(m_head)};
+        m_head = (m_head + 1) % Capacity;
+        --m_count;
+        return item;
+    }
+
+    // Callbacks cannot be default constructed, hence the optionals
+    IsrLock                                   m_lock {};
+    std::array<std::optional<Item>, Capacity> m_items {};
+    std::size_t                               m_head {0};
+    std::uint32_t                             m_count {0};
+
+    std::atomic<std::uint32_t> m_deferred {0};
+    std::atomic<std::uint32_t> m_overflows {0};
+    std::atomic<std::uint32_t> m_high_water {0};
+    scheduling::ExecutionStats m_latency {};
+};
+}  // namespace detail
+
+/**
+ * @brief Task which runs work deferred to it by interrupts and other tasks.
+ *
+ * Interrupt handlers should do only what must happen in interrupt context
+ * (such as acknowledging the peripheral) and defer the rest, such as decoding
+ * frames or feeding listeners, to an executor:
+ *
+ * @code
+ * DeferredExecutor<> deferred {"Deferred", osPriorityHigh};
+ *
+ * void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef*, uint32_t) {
+ *     deferred.DeferFromIsr(OBC_CALLBACK_METHOD(can, Drain));
+ * }
+ * @endcode
+ *
+ * Work runs in the order it was deferred, one item at a time. Drivers share
+ * executors rather than each having a task, and urgent work should be given
+ * its own executor at a higher priority.
+ *
+ * Each item's execution time and latency (from being deferred to completing)
+ * are recorded, so the priority of an executor can be chosen from measured
+ * response times.
+ *
+ * @tparam Capacity Most items which may be queued at once, further items are
+ * dropped and counted.
+ * @tparam StackDepth Stack depth of the task, which work runs on.
+ */
+template<
+    std::size_t   Capacity   = 32,
+    std::uint32_t StackDepth = scheduling::kDefaultStackDepth>
+class DeferredExecutor : private detail::DeferredQueue<Capacity>,
+                         public scheduling::StackTask<StackDepth> {
+    static_assert(Capacity > 0);
+
+    using Queue = detail::DeferredQueue<Capacity>;
+
+  public:
+    using typename Queue::Snapshot;
+    using Queue::Stats;
+
+    /**
+     * @brief Creates and starts the executor's task.
+     *
+     * @param name Name of the task.
+     * @param priority Priority of the task, which all work runs at.
+     */
+    explicit DeferredExecutor(
+        const char*      name     = "Deferred",
+        const osPriority priority = osPriorityHigh
+    )
+        // The task is constructed after the queue, as it may start running
+        // immediately. Its period only bounds how long it sleeps without work.
+        : scheduling::StackTask<StackDepth>(
+              name, units::seconds<float>(1), priority
+          ) {}
+
+    /**
+     * @brief Queues work to run on the executor's task.
+     *
+     * @param work Callback to invoke.
+     *
+     * @return False if the queue was full and the work was dropped.
+     */
+    auto Defer(Callback<void> work) -> bool {
+        if (!this->Push(work)) return false;
+        this->Notify();
+        return true;
+    }
+
+    /**
+     * @brief Same as \ref Defer, but safe to call from an interrupt.
+     */
+    auto DeferFromIsr(Callback<void> work) -> bool {
+        if (!this->Push(work)) return false;
+        this->NotifyFromIsr();
+        return true;
+    }
+
+  protected:
+    auto Run(scheduling::WakeReason /*reason*/) -> void override {
+        this->Drain();
+    }
+};
+}  // namespace obc::ipc
@@ -0,0 +1,80 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <cstdint>
+
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::ipc {
+/**
+ * @brief An interrupt which one core raises to wake a task on the other.
+ *
+ * On the STM32, each doorbell is one of the hardware semaphores (HSEM).
+ * Ringing takes and releases the semaphore, which interrupts the other core if
+ * it listens for that semaphore. On the host, both "cores" are threads of one
+ * process and a ring gives the listener's notification directly.
+ *
+ * A doorbell is only an identifier, so it may be kept in memory shared by the
+ * cores. Each doorbell should be rung by one core and listened to by the
+ * other. Semaphore 0 is used to release the CM4 at boot and semaphore 31 to
+ * start the shared microsecond clock, so neither may be used as a doorbell.
+ *
+ * @note Rings are not counted. A ring while nothing listens is lost, so the
+ * listener must recheck whatever it waits for after it starts listening.
+ */
+class Doorbell {
+  public:
+    /// Number of doorbells, one per hardware semaphore.
+    static constexpr std::uint32_t kCount = 32;
+
+    /**
+     * @brief Refers to a doorbell.
+     *
+     * @param id Index of the hardware semaphore, less than \ref kCount.
+     */
+    constexpr explicit Doorbell(std::uint32_t id) : m_id(id) {}
+
+    /**
+     * @brief Wakes the task listening for the doorbell on the other core.
+     *
+     * Safe to call from interrupts.
+     */
+    auto Ring() const -> void;
+
+    /**
+     * @brief Gives a notification whenever the doorbell is rung.
+     *
+     * Replaces any notification given to an earlier call.
+     *
+     * @param listener The notification.
+     */
+    auto Listen(scheduling::Notification listener) const -> void;
+
+    /**
+     * @brief Stops giving the notification registered by \ref Listen.
+     */
+    auto Ignore() const -> void;
+
+  private:
+    std::uint32_t m_id;
+};
+}  // namespace obc::ipc
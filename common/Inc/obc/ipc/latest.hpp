@@ -0,0 +1,164 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace obc::ipc {
+/**
+ * @brief A register holding the most recent value of some state, such as a
+ * sensor snapshot, which readers copy out without locking.
+ *
+ * This is a sequence lock with two copies of the value. The writer bumps the
+ * sequence number around updating each copy in turn, and a reader copies
+ * whichever copy the sequence number says is stable, retrying only if the
+ * number changed meanwhile. Neither side masks interrupts or blocks, so
+ * reading at a high rate costs no interrupt latency, unlike \ref AsyncValue
+ * and other users of \ref SpinLock.
+ *
+ * Since one copy is always stable, a reader which preempts the writer
+ * part-way through an update still completes, so the register may be written
+ * and read from any mix of interrupts and tasks. A reader retries only when
+ * a write completes on another core or in an interrupt during its copy.
+ *
+ * @code
+ * Latest<ImuReading> g_imu {};
+ *
+ * // IMU data-ready interrupt
+ * g_imu.Write(reading);
+ *
+ * // Any task, at any rate
+ * const auto imu {g_imu.Read()};
+ * @endcode
+ *
+ * @note To share it between the cores, the register must be placed in memory
+ * which both cores see coherently, such as a non-cacheable region of D2 SRAM.
+ *
+ * @warning There must be only one writer at a time; concurrent writes must be
+ * serialised by the caller.
+ *
+ * @tparam T Type of value, copied in and out.
+ */
+template<typename T>
+class Latest {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    using Word = std::uint32_t;
+    static_assert(std::atomic<Word>::is_always_lock_free);
+
+    static constexpr std::size_t kWords =
+        (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+  public:
+    /**
+     * @brief Creates a register.
+     *
+     * @param initial Value read until the first write.
+     */
+    explicit Latest(const T& initial = {}) {
+        Store(0, initial);
+        Store(1, initial);
+    }
+
+    Latest(const Latest&)                    = delete;
+    Latest(Latest&&)                         = delete;
+    auto operator=(const Latest&) -> Latest& = delete;
+    auto operator=(Latest&&) -> Latest&      = delete;
+    ~Latest()                                = default;
+
+    /**
+     * @brief Replaces the value.
+     *
+     * Never blocks, so is safe to call from interrupts.
+     *
+     * @param value The new value.
+     */
+    auto Write(const T& value) -> void {
+        const auto sequence {m_sequence.load(std::memory_order_relaxed)};
+
+        // An odd sequence number sends readers to copy 1 while copy 0 changes,
+        // and releases the previous write's update of copy 1 to them
+        m_sequence.store(sequence + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        Store(0, value);
+
+        // Then an even one sends them back to copy 0 while copy 1 catches up
+        m_sequence.store(sequence + 2, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        Store(1, value);
+    }
+
+    /**
+     * @brief Copies out the value.
+     *
+     * Never blocks, so is safe to call from interrupts.
+     *
+     * @return The most recently written value.
+     */
+    [[nodiscard]] auto Read() const -> T {
+        std::array<Word, kWords> words {};
+        for (;;) {
+            const auto sequence {m_sequence.load(std::memory_order_acquire)};
+            const auto& copy {m_copies[sequence & 1]};
+            for (std::size_t i {0}; i < kWords; ++i)
+                words[i] = copy[i].load(std::memory_order_relaxed);
+
+            // Orders the copy before the recheck of the sequence number
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence) break;
+        }
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Gets the number of writes so far.
+     *
+     * Readers may compare this with an earlier count to tell whether the
+     * value has changed.
+     *
+     * @return The number of writes, wrapping on overflow.
+     */
+    [[nodiscard]] auto Writes() const -> std::uint32_t {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    auto Store(std::size_t index, const T& value) -> void {
+        std::array<Word, kWords> words {};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (std::size_t i {0}; i < kWords; ++i)
+            m_copies[index][i].store(words[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<Word>                                    m_sequence {0};
+    // Copies are read and written a word at a time so that torn reads, which
+    // are discarded, are not data races
+    std::array<std::array<std::atomic<Word>, kWords>, 2> m_copies {};
+};
+}  // namespace obc::ipc
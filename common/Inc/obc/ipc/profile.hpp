@@ -0,0 +1,314 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <units/time.h>
+
+namespace obc::ipc {
+/**
+ * @brief Kind of primitive a lock profile site was recorded for.
+ */
+enum class LockKind : std::uint8_t {
+    kMutex,
+    kSpinLock,
+    kIsrLock,
+    kCritical,
+};
+
+/**
+ * @brief Timing of one site which takes a lock, as recorded by the lock
+ * profiler.
+ */
+struct LockSiteStats {
+    /// Return address of the call which took the lock, which `addr2line`
+    /// resolves to the source line.
+    const void*                site {nullptr};
+    LockKind                   kind {LockKind::kMutex};
+    /// Number of times the lock was taken.
+    std::uint32_t              acquisitions {0};
+    /// Number of times the lock was already held by someone else.
+    std::uint32_t              contended {0};
+    /// Mean time spent waiting to take the lock.
+    units::microseconds<float> mean_wait {0};
+    /// Longest time spent waiting to take the lock.
+    units::microseconds<float> max_wait {0};
+    /// Mean time the lock was held.
+    units::microseconds<float> mean_hold {0};
+    /// Longest time the lock was held.
+    units::microseconds<float> max_hold {0};
+    /// Longest window with interrupts masked which this site opened,
+    /// including any locks nested inside it. Zero for mutexes.
+    units::microseconds<float> max_masked {0};
+};
+
+/**
+ * @brief Statistics of every site which takes an ipc lock, recorded when built
+ * with `BALLOON_LOCK_PROFILING`.
+ *
+ * Every \ref Mutex, \ref SpinLock, \ref IsrLock and \ref CriticalGuard then
+ * times how long each acquisition waited and held the lock, and how long
+ * interrupts stayed masked. Results are kept per call site and per core, so
+ * the locks adding to interrupt latency, such as that of CAN reception, can be
+ * found before anything is tuned. Timing uses the cycle counter on the STM32.
+ *
+ * Without the option the locks carry no instrumentation and nothing is
+ * recorded.
+ */
+class LockProfile {
+  public:
+    /// Most sites which can be told apart, later sites are dropped.
+    static constexpr std::size_t kSites = 32;
+
+    /**
+     * @brief Copies the statistics recorded so far.
+     *
+     * @param sites Filled with one entry per site, in order of first use.
+     *
+     * @return Number of entries written.
+     */
+    static auto Read(std::span<LockSiteStats> sites) -> std::size_t;
+
+    /**
+     * @brief Gets the number of acquisitions not recorded because the table
+     * of sites was full.
+     *
+     * @return The number of acquisitions.
+     */
+    static auto Dropped() -> std::uint32_t;
+
+    /**
+     * @brief Discards all recorded statistics.
+     */
+    static auto Reset() -> void;
+};
+
+namespace detail {
+#ifdef BALLOON_LOCK_PROFILING
+constexpr bool kLockProfiling = true;
+#else
+constexpr bool kLockProfiling = false;
+#endif
+
+/**
+ * @brief Accumulated timing of each lock site, in clock ticks.
+ *
+ * Not thread safe, the backend serialises access.
+ */
+class LockSiteTable {
+  public:
+    /**
+     * @brief Records one acquisition and release of a lock.
+     */
+    auto Record(
+        const void* site, LockKind kind, std::uint32_t wait,
+        std::uint32_t hold, bool contended
+    ) -> void {
+        auto* entry {Find(site, kind)};
+        if (!entry) {
+            ++m_dropped;
+            return;
+        }
+
+        ++entry->acquisitions;
+        if (contended) ++entry->contended;
+        entry->total_wait += wait;
+        entry->total_hold += hold;
+        entry->max_wait = std::max(entry->max_wait, wait);
+        entry->max_hold = std::max(entry->max_hold, hold);
+    }
+
+    /**
+     * @brief Records the end of the outermost window with interrupts masked.
+     */
+    auto RecordMasked(const void* site, LockKind kind, std::uint32_t window)
+        -> void {
+        if (auto* entry {Find(site, kind)})
+            entry->max_masked = std::max(entry->max_masked, window);
+    }
+
+    /**
+     * @brief Converts the table for \ref LockProfile::Read.
+     *
+     * @param sites Filled with one entry per site.
+     * @param ticks_per_us Rate of the clock the table was recorded with.
+     *
+     * @return Number of entries written.
+     */
+    auto Read(std::span<LockSiteStats> sites, float ticks_per_us) const
+        -> std::size_t {
+        const auto us {[&](auto ticks) {
+            return units::microseconds<float>(
+                static_cast<float>(ticks) / ticks_per_us
+            );
+        }};
+        const auto mean {[&](std::uint64_t total, std::uint32_t count) {
+            return us(count ? static_cast<float>(total) / count : 0.0F);
+        }};
+
+        const auto count {std::min(sites.size(), m_used)};
+        for (std::size_t i {0}; i < count; ++i) {
+            const auto& entry {m_entries[i]};
+            sites[i] = {
+                .site         = entry.site,
+                .kind         = entry.kind,
+                .acquisitions = entry.acquisitions,
+                .contended    = entry.contended,
+                .mean_wait    = mean(entry.total_wait, entry.acquisitions),
+                .max_wait     = us(entry.max_wait),
+                .mean_hold    = mean(entry.total_hold, entry.acquisitions),
+                .max_hold     = us(entry.max_hold),
+                .max_masked   = us(entry.max_masked),
+            };
+        }
+        return count;
+    }
+
+    [[nodiscard]] auto Dropped() const -> std::uint32_t { return m_dropped; }
+
+  private:
+    struct Entry {
+        const void*   site {nullptr};
+        LockKind      kind {LockKind::kMutex};
+        std::uint32_t acquisitions {0};
+        std::uint32_t contended {0};
+        std::uint64_t total_wait {0};
+        std::uint64_t total_hold {0};
+        std::uint32_t max_wait {0};
+        std::uint32_t max_hold {0};
+        std::uint32_t max_masked {0};
+    };
+
+    /**
+     * @brief Finds the entry of a site, adding it if there is space.
+     */
+    auto Find(const void* site, LockKind kind) -> Entry* {
+        // Sites are few, so a linear scan beats hashing on a Cortex-M
+        for (std::size_t i {0}; i < m_used; ++i) {
+            auto& entry {m_entries[i]};
+            if (entry.site == site && entry.kind == kind) return &entry;
+        }
+        if (m_used == m_entries.size()) return nullptr;
+
+        auto& entry {m_entries[m_used++]};
+        entry.site = site;
+        entry.kind = kind;
+        return &entry;
+    }
+
+    std::array<Entry, LockProfile::kSites> m_entries {};
+    std::size_t                            m_used {0};
+    std::uint32_t                          m_dropped {0};
+};
+
+#ifdef BALLOON_LOCK_PROFILING
+/**
+ * @brief Reads the profiling clock.
+ *
+ * @return The time, in ticks which wrap.
+ */
+auto ProfileNow() -> std::uint32_t;
+
+/**
+ * @brief Adds an acquisition to the profile of the calling core.
+ */
+auto RecordLock(
+    const void* site, LockKind kind, std::uint32_t wait, std::uint32_t hold,
+    bool contended
+) -> void;
+
+/**
+ * @brief Marks that interrupts were just masked by a site.
+ *
+ * Only the outermost of nested windows is timed.
+ */
+auto MaskBegin(const void* site, LockKind kind) -> void;
+
+/**
+ * @brief Marks that interrupts are about to be unmasked.
+ */
+auto MaskEnd() -> void;
+
+/**
+ * @brief Times one lock from the start of acquisition to its release.
+ */
+class LockProbe {
+  public:
+    /**
+     * @brief Marks the start of an attempt to take the lock.
+     *
+     * @return Time of the attempt, to be passed to \ref Acquired.
+     */
+    auto Start() -> std::uint32_t { return ProfileNow(); }
+
+    /**
+     * @brief Marks that the lock was taken, by the holder.
+     */
+    auto Acquired(const void* site, std::uint32_t start, bool contended)
+        -> void {
+        m_site      = site;
+        m_start     = start;
+        m_acquired  = ProfileNow();
+        m_contended = contended;
+    }
+
+    /**
+     * @brief Records the acquisition, by the holder just before releasing.
+     */
+    auto Released(LockKind kind) -> void {
+        const auto now {ProfileNow()};
+        RecordLock(
+            m_site, kind, m_acquired - m_start, now - m_acquired, m_contended
+        );
+    }
+
+  private:
+    const void*   m_site {nullptr};
+    std::uint32_t m_start {0};
+    std::uint32_t m_acquired {0};
+    bool          m_contended {false};
+};
+#else
+inline auto MaskBegin(const void* /*site*/, LockKind /*kind*/) -> void {}
+
+inline auto MaskEnd() -> void {}
+
+/**
+ * @brief Stand-in for the lock probe which compiles away.
+ */
+class LockProbe {
+  public:
+    auto Start() -> std::uint32_t { return 0; }
+
+    auto Acquired(
+        const void* /*site*/, std::uint32_t /*start*/, bool /*contended*/
+    ) -> void {}
+
+    auto Released(LockKind /*kind*/) -> void {}
+};
+#endif
+}  // namespace detail
+}  // namespace obc::ipc
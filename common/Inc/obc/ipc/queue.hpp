@@ -0,0 +1,296 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/ipc/ring.hpp"
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::ipc {
+namespace detail {
+/**
+ * @brief Notifications of the tasks blocked on one side of a queue.
+ *
+ * Waking is lock-free while nothing is registered, so only queues which
+ * actually have blocked tasks pay for the lock.
+ *
+ * @tparam N Most tasks which may be registered at once.
+ */
+template<std::size_t N>
+class WaiterList {
+  public:
+    /**
+     * @brief Registers the calling task to be woken.
+     *
+     * @return Index of the registration, or std::nullopt if the list is full.
+     */
+    auto Add() -> std::optional<std::size_t> {
+        std::scoped_lock lock(m_lock);
+        for (std::size_t i {0}; i < N; ++i) {
+            auto& slot {m_slots.at(i)};
+            if (slot) continue;
+
+            slot.emplace(scheduling::Notification::Current());
+            m_count.fetch_add(1, std::memory_order_seq_cst);
+            // The caller's next check of the queue must not be reordered
+            // before the registration, or a wake could be missed
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return i;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Removes a registration.
+     *
+     * @param index Index returned by \ref Add.
+     */
+    auto Remove(std::size_t index) -> void {
+        std::scoped_lock lock(m_lock);
+        m_slots.at(index).reset();
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Wakes every registered task, which then rechecks the queue.
+     */
+    auto WakeAll() -> void {
+        // Pairs with the fence in Add, ordering the queue update before this
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!m_count.load(std::memory_order_relaxed)) return;
+
+        std::scoped_lock lock(m_lock);
+        for (auto& slot : m_slots)
+            if (slot) slot->Give();
+    }
+
+  private:
+    SpinLock                                                m_lock {};
+    std::array<std::optional<scheduling::Notification>, N> m_slots {};
+    std::atomic<std::uint32_t>                              m_count {0};
+};
+}  // namespace detail
+
+/**
+ * @brief A bounded lock-free queue for any number of producers and
+ * consumers.
+ *
+ * Each cell carries a sequence number which says whether it is ready to be
+ * written or read on the current lap of the queue, so producers and consumers
+ * only contend on the index of their own side, claimed with a single
+ * compare-and-swap. This suits several tasks feeding one logging or
+ * telemetry task, where a \ref Mutex would block a producer behind another
+ * and a \ref SpinLock would mask interrupts.
+ *
+ * The `Try` operations never block. The blocking operations wait on the
+ * calling task's wait notification, which the other side gives when it
+ * changes the queue, so no CPU time is spent while waiting. Up to `Waiters`
+ * tasks per side wait this way, any more poll with backoff instead.
+ *
+ * @code
+ * MpmcQueue<LogRecord, 64> g_logs {};
+ *
+ * // Any task
+ * g_logs.TryPush(record);
+ *
+ * // Logging task
+ * while (auto record {g_logs.Pop(units::milliseconds<float>(100))})
+ *     Write(*record);
+ * @endcode
+ *
+ * @note Blocking operations and wake-ups use task-level primitives, so the
+ * queue must not be used from interrupts.
+ *
+ * @tparam T Type of element, copied in and out.
+ * @tparam Capacity Number of elements, a power of two.
+ * @tparam Waiters Most tasks which may block on each side at once.
+ */
+template<typename T, std::size_t Capacity, std::size_t Waiters = 4>
+class MpmcQueue {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(
+        Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two"
+    );
+
+  public:
+    /// Number of elements the queue can hold.
+    static constexpr std::size_t kCapacity = Capacity;
+
+    MpmcQueue() {
+        for (std::size_t i {0}; i < Capacity; ++i)
+            m_cells.at(i).sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&)                    = delete;
+    MpmcQueue(MpmcQueue&&)                         = delete;
+    auto operator=(const MpmcQueue&) -> MpmcQueue& = delete;
+    auto operator=(MpmcQueue&&) -> MpmcQueue&      = delete;
+    ~MpmcQueue()                                   = default;
+
+    /**
+     * @brief Appends an element if there is space.
+     *
+     * @param value The element.
+     *
+     * @return False if the queue was full.
+     */
+    auto TryPush(const T& value) -> bool {
+        auto pos {m_enqueue.load(std::memory_order_relaxed)};
+        Cell* cell {nullptr};
+        for (;;) {
+            cell = &m_cells[pos & kMask];
+            const auto lap {static_cast<std::ptrdiff_t>(
+                cell->sequence.load(std::memory_order_acquire) - pos
+            )};
+
+            if (lap == 0) {
+                if (m_enqueue.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed
+                    ))
+                    break;
+            } else if (lap < 0) {
+                // The cell still holds an element from the previous lap
+                return false;
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        m_consumers.WakeAll();
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element if there is one.
+     *
+     * @return The element, or std::nullopt if the queue was empty.
+     */
+    auto TryPop() -> std::optional<T> {
+        auto pos {m_dequeue.load(std::memory_order_relaxed)};
+        Cell* cell {nullptr};
+        for (;;) {
+            cell = &m_cells[pos & kMask];
+            const auto lap {static_cast<std::ptrdiff_t>(
+                cell->sequence.load(std::memory_order_acquire) - (pos + 1)
+            )};
+
+            if (lap == 0) {
+                if (m_dequeue.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed
+                    ))
+                    break;
+            } else if (lap < 0) {
+                // The cell has not been written on this lap
+                return std::nullopt;
+            } else {
+                pos = m_dequeue.load(std::memory_order_relaxed);
+            }
+        }
+
+        const T value {cell->value};
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        m_producers.WakeAll();
+        return value;
+    }
+
+    /**
+     * @brief Appends an element, waiting for space if the queue is full.
+     *
+     * @param value The element.
+     * @param timeout Longest time to wait.
+     *
+     * @return False if the queue stayed full until the timeout.
+     */
+    auto Push(const T& value, scheduling::Duration timeout) -> bool {
+        if (TryPush(value)) return true;
+        return Wait(m_producers, timeout, [&] { return TryPush(value); });
+    }
+
+    /**
+     * @brief Removes the oldest element, waiting for one if the queue is
+     * empty.
+     *
+     * @param timeout Longest time to wait.
+     *
+     * @return The element, or std::nullopt if the queue stayed empty until
+     * the timeout.
+     */
+    auto Pop(scheduling::Duration timeout) -> std::optional<T> {
+        if (auto value {TryPop()}) return value;
+        return Wait(m_consumers, timeout, [&] { return TryPop(); });
+    }
+
+    /**
+     * @brief Gets the approximate number of elements in the queue.
+     *
+     * @return The number of elements, only a snapshot while other tasks are
+     * using the queue.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t {
+        const auto dequeued {m_dequeue.load(std::memory_order_acquire)};
+        const auto enqueued {m_enqueue.load(std::memory_order_acquire)};
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence {0};
+        T                        value {};
+    };
+
+    /**
+     * @brief Polls an operation until it succeeds, sleeping on the calling
+     * task's wait notification between attempts.
+     */
+    template<typename F>
+    static auto Wait(
+        detail::WaiterList<Waiters>& waiters, scheduling::Duration timeout,
+        F&& f
+    ) {
+        scheduling::Timeout deadline {timeout};
+        const auto          index {waiters.Add()};
+        if (!index) return deadline.Poll(f, scheduling::wait::Backoff {});
+
+        auto result {deadline.Poll(f, scheduling::wait::Notify {})};
+        waiters.Remove(*index);
+        return result;
+    }
+
+    alignas(kCacheLineSize) std::array<Cell, Capacity> m_cells {};
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_enqueue {0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_dequeue {0};
+    detail::WaiterList<Waiters> m_producers {};
+    detail::WaiterList<Waiters> m_consumers {};
+};
+}  // namespace obc::ipc
@@ -0,0 +1,227 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace obc::ipc {
+/**
+ * @brief Size of a data cache line, which independently written indices are
+ * kept apart by.
+ *
+ * The Cortex-M7 has 32 byte lines, 64 bytes is typical of host CPUs.
+ */
+#ifdef BALLOON_STM32
+constexpr std::size_t kCacheLineSize = 32;
+#else
+constexpr std::size_t kCacheLineSize = 64;
+#endif
+
+/**
+ * @brief A lock-free single-producer, single-consumer ring buffer.
+ *
+ * One context may push and one other context may pop concurrently without any
+ * critical section, so this is suitable between an interrupt and a task as
+ * well as between two tasks. Each index is written by one side only and is
+ * kept on its own cache line, so the two sides do not contend for a line.
+ *
+ * Elements live in storage given to the ring, which may be placed in any
+ * memory, such as a DMA-capable SRAM bank. The CPU's view of the storage must
+ * be coherent with the other side, so with the data cache enabled it should be
+ * in a non-cacheable region or be maintained around DMA transfers. See
+ * \ref StaticSpscRing for a ring which owns its storage.
+ *
+ * @code
+ * StaticSpscRing<std::byte, 512> rx {};
+ *
+ * void HAL_UART_RxCpltCallback(UART_HandleTypeDef*) { rx.TryPush(byte); }
+ *
+ * auto Run(WakeReason) -> void {
+ *     std::array<std::byte, 64> chunk {};
+ *     while (auto n {rx.Pop(chunk)}) Decode(std::span(chunk).first(n));
+ * }
+ * @endcode
+ *
+ * @warning Having more than one producer or more than one consumer at a time
+ * is a data race.
+ *
+ * @tparam T Type of element, which is copied in and out.
+ * @tparam Capacity Number of elements, a power of two.
+ */
+template<std::semiregular T, std::size_t Capacity>
+class SpscRing {
+    static_assert(
+        Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two"
+    );
+
+  public:
+    /// Number of elements the ring can hold.
+    static constexpr std::size_t kCapacity = Capacity;
+
+    /**
+     * @brief Creates an empty ring using external storage.
+     *
+     * @param storage Storage for the elements, which must outlive the ring.
+     */
+    explicit SpscRing(std::span<T, Capacity> storage) : m_storage(storage) {}
+
+    SpscRing(const SpscRing&)                    = delete;
+    SpscRing(SpscRing&&)                         = delete;
+    auto operator=(const SpscRing&) -> SpscRing& = delete;
+    auto operator=(SpscRing&&) -> SpscRing&      = delete;
+    ~SpscRing()                                  = default;
+
+    /**
+     * @brief Appends an element, producer only.
+     *
+     * @param value The element.
+     *
+     * @return False if the ring was full and the element was not added.
+     */
+    auto TryPush(const T& value) -> bool {
+        const auto tail {m_tail.load(std::memory_order_relaxed)};
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_storage[tail & kMask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Appends as many elements as fit, producer only.
+     *
+     * @param values The elements, in order.
+     *
+     * @return Number of elements added, taken from the front of values.
+     */
+    auto Push(std::span<const T> values) -> std::size_t {
+        const auto tail {m_tail.load(std::memory_order_relaxed)};
+        const auto free {
+            Capacity - (tail - m_head.load(std::memory_order_acquire))
+        };
+        const auto count {std::min(values.size(), free)};
+
+        // The free space may wrap around the end of the storage
+        const auto start {tail & kMask};
+        const auto first {std::min(count, Capacity - start)};
+        std::ranges::copy(values.first(first), m_storage.begin() + start);
+        std::ranges::copy(
+            values.subspan(first, count - first), m_storage.begin()
+        );
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Removes the oldest element, consumer only.
+     *
+     * @return The element, or std::nullopt if the ring was empty.
+     */
+    auto TryPop() -> std::optional<T> {
+        const auto head {m_head.load(std::memory_order_relaxed)};
+        if (head == m_tail.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> value {m_storage[head & kMask]};
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Removes as many elements as are available and fit, consumer
+     * only.
+     *
+     * @param values Filled with the oldest elements, in order.
+     *
+     * @return Number of elements removed, written to the front of values.
+     */
+    auto Pop(std::span<T> values) -> std::size_t {
+        const auto head {m_head.load(std::memory_order_relaxed)};
+        const auto used {m_tail.load(std::memory_order_acquire) - head};
+        const auto count {std::min(values.size(), used)};
+
+        const auto start {head & kMask};
+        const auto first {std::min(count, Capacity - start)};
+        std::ranges::copy(m_storage.subspan(start, first), values.begin());
+        std::ranges::copy(
+            m_storage.first(count - first), values.begin() + first
+        );
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of elements in the ring.
+     *
+     * Only a snapshot when read while the other side is active.
+     *
+     * @return The number of elements.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Checks if the ring holds no elements.
+     *
+     * @return True if empty.
+     */
+    [[nodiscard]] auto Empty() const -> bool { return Size() == 0; }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    static_assert(std::atomic<std::size_t>::is_always_lock_free);
+
+    // Free-running counts, which wrap cleanly as the capacity divides 2^N
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_head {0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_tail {0};
+    alignas(kCacheLineSize) std::span<T, Capacity> m_storage;
+};
+
+/**
+ * @brief A \ref SpscRing which holds its own storage.
+ *
+ * @tparam T Type of element.
+ * @tparam Capacity Number of elements, a power of two.
+ */
+template<std::semiregular T, std::size_t Capacity>
+class StaticSpscRing : public SpscRing<T, Capacity> {
+  public:
+    StaticSpscRing() : SpscRing<T, Capacity>(m_elements) {}
+
+  private:
+    // The base only keeps a view of this, so may be given it before it exists
+    std::array<T, Capacity> m_elements {};
+};
+}  // namespace obc::ipc
@@ -0,0 +1,589 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "obc/ipc/callback.hpp"
+#include "obc/ipc/channel.hpp"
+#include "obc/ipc/doorbell.hpp"
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::ipc {
+/**
+ * @brief Outcome of a call, as reported by the serving core.
+ */
+enum class RpcStatus : std::uint8_t {
+    /// The handler ran and the payload holds its result.
+    kOk,
+    /// No handler is bound to the procedure.
+    kUnbound,
+};
+
+/**
+ * @brief Compile-time description of a procedure which one core may call on
+ * the other.
+ *
+ * @tparam Id Identifier of the procedure, unique within a \ref Protocol.
+ * @tparam A Type of argument.
+ * @tparam R Type of result.
+ */
+template<auto Id, typename A, typename R>
+struct Procedure {
+    static_assert(std::is_trivially_copyable_v<A>);
+    static_assert(std::is_trivially_copyable_v<R>);
+
+    static constexpr auto kId = Id;
+
+    using Argument = A;
+    using Result   = R;
+};
+
+/**
+ * @brief The set of procedures served over an \ref RpcLink.
+ *
+ * Both cores must be built with the same protocol, as procedures are sent by
+ * their position in it.
+ *
+ * @tparam Procs Each \ref Procedure, whose identifiers must all have the same
+ * type.
+ */
+template<typename... Procs>
+struct Protocol {
+    /// Number of procedures.
+    static constexpr std::size_t kCount = sizeof...(Procs);
+
+    /// Size of the largest argument or result.
+    static constexpr std::size_t kPayloadSize = std::max(
+        {sizeof(typename Procs::Argument)..., sizeof(typename Procs::Result)...}
+    );
+
+    /// The procedure at a position.
+    template<std::size_t I>
+    using At = std::tuple_element_t<I, std::tuple<Procs...>>;
+
+    /**
+     * @brief Gets the position of a procedure.
+     *
+     * @tparam Id Identifier of the procedure.
+     *
+     * @return The position.
+     */
+    template<auto Id>
+    static consteval auto IndexOf() -> std::uint16_t {
+        constexpr std::array<bool, kCount> kMatches {(Procs::kId == Id)...};
+        static_assert(
+            std::ranges::count(kMatches, true) == 1,
+            "Procedure identifiers must be unique"
+        );
+        return std::ranges::find(kMatches, true) - kMatches.begin();
+    }
+
+    /// The procedure with an identifier.
+    template<auto Id>
+    using Find = At<IndexOf<Id>()>;
+
+    /// Handler of each procedure, if bound.
+    using Handlers = std::tuple<std::optional<
+        Callback<typename Procs::Result, const typename Procs::Argument&>>...>;
+
+    /// Receiver of the result of any procedure, or of the status of its
+    /// failure, the alternative at its position.
+    using Receiver = std::variant<Callback<
+        void, const std::expected<typename Procs::Result, RpcStatus>&>...>;
+};
+
+/**
+ * @brief A request or response as it is laid out in shared memory.
+ *
+ * @tparam Size Size of the payload.
+ */
+template<std::size_t Size>
+struct RpcFrame {
+    /// Position of the procedure in the protocol.
+    std::uint16_t                          procedure;
+    /// Index of the call in the caller's in-flight table.
+    std::uint16_t                          slot;
+    /// Distinguishes the call from earlier calls in the same slot.
+    std::uint32_t                          sequence;
+    RpcStatus                              status;
+    alignas(8) std::array<std::byte, Size> payload;
+};
+
+/**
+ * @brief The shared-memory half of a remote procedure call connection, which
+ * carries calls from one core to the other and results back.
+ *
+ * Like a \ref CoreChannel, a link is placed with \ref OBC_SHARED and reset by
+ * one core before either side uses it. One core then runs an \ref RpcClient
+ * on it and the other an \ref RpcServer. For calls in both directions, use
+ * two links.
+ *
+ * @tparam P The \ref Protocol.
+ * @tparam Depth Number of requests and of responses which may be queued, a
+ * power of two.
+ */
+template<typename P, std::size_t Depth = 4>
+class RpcLink {
+  public:
+    using Protocol = P;
+    using Frame    = RpcFrame<P::kPayloadSize>;
+    using Channel  = CoreChannel<Frame, Depth>;
+
+    constexpr RpcLink() = default;
+
+    /**
+     * @brief Empties the link and assigns its doorbells.
+     *
+     * Must be called by one core while the other is not yet using the link.
+     *
+     * @param first_doorbell First of four consecutive doorbells used by the
+     * link.
+     */
+    auto Reset(std::uint32_t first_doorbell) -> void {
+        m_requests.Reset(
+            Doorbell(first_doorbell), Doorbell(first_doorbell + 1)
+        );
+        m_responses.Reset(
+            Doorbell(first_doorbell + 2), Doorbell(first_doorbell + 3)
+        );
+    }
+
+    /**
+     * @brief Gets the channel carrying calls to the serving core.
+     */
+    auto Requests() -> Channel& { return m_requests; }
+
+    /**
+     * @brief Gets the channel carrying results back to the calling core.
+     */
+    auto Responses() -> Channel& { return m_responses; }
+
+  private:
+    Channel m_requests {};
+    Channel m_responses {};
+};
+
+/**
+ * @brief Counters of an \ref RpcClient.
+ */
+struct RpcStats {
+    /// Calls sent to the other core.
+    std::uint32_t calls;
+    /// Calls refused because too many were in flight or the link was full.
+    std::uint32_t rejected;
+    /// Calls abandoned at their timeout, whose late results are discarded.
+    std::uint32_t timeouts;
+    /// Calls the other core could not serve.
+    std::uint32_t failed;
+};
+
+/**
+ * @brief Calls procedures served by the other core.
+ *
+ * A call copies its argument into a request on the link and returns at once.
+ * Its result is delivered to a callback, or to an \ref AsyncValue, on this
+ * core when the task running \ref Service receives the response. Each call has
+ * a timeout, after which it is abandoned and its slot reused, and at most
+ * `MaxInFlight` calls are outstanding at once.
+ *
+ * @code
+ * // Shared header
+ * enum class Service : std::uint8_t { kFuse, kCompress };
+ * using OffloadProtocol = Protocol<
+ *     Procedure<Service::kFuse, ImuBatch, Attitude>,
+ *     Procedure<Service::kCompress, Block, Compressed>>;
+ * OBC_SHARED constinit RpcLink<OffloadProtocol> g_offload {};
+ *
+ * // CM4
+ * RpcClient client {g_offload};
+ * // ... with a task looping on client.Service(...)
+ * auto attitude {
+ *     client.Call<Service::kFuse>(batch, units::milliseconds<float>(5))
+ * };
+ * @endcode
+ *
+ * @note Any number of tasks may call, but only one may run \ref Service.
+ * Results are delivered from that task with the client locked, so callbacks
+ * must be short and must not call back into the client.
+ *
+ * @tparam Link The \ref RpcLink.
+ * @tparam MaxInFlight Most calls outstanding at once.
+ */
+template<typename Link, std::size_t MaxInFlight = 4>
+class RpcClient {
+    using P     = typename Link::Protocol;
+    using Frame = typename Link::Frame;
+
+    template<auto Id>
+    using Argument = typename P::template Find<Id>::Argument;
+    template<auto Id>
+    using Result = typename P::template Find<Id>::Result;
+    template<auto Id>
+    using Outcome = std::expected<Result<Id>, RpcStatus>;
+
+  public:
+    /**
+     * @brief Creates a client.
+     *
+     * @param link The link, which must outlive the client.
+     */
+    explicit RpcClient(Link& link) : m_link(link) {}
+
+    /**
+     * @brief Calls a procedure without waiting for it to complete.
+     *
+     * @param argument Argument of the call.
+     * @param done Given the result once it arrives, or the status if the
+     * other core could not serve the call. Not called if the call times out.
+     * @param timeout Time after which the call is abandoned.
+     *
+     * @tparam Id Identifier of the procedure.
+     *
+     * @return False if the call could not be sent.
+     */
+    template<auto Id>
+    auto Call(
+        const Argument<Id>& argument, Callback<void, const Outcome<Id>&> done,
+        scheduling::Duration timeout
+    ) -> bool {
+        return Start<Id>(argument, done, timeout).has_value();
+    }
+
+    /**
+     * @brief Calls a procedure and blocks until its result arrives.
+     *
+     * @param argument Argument of the call.
+     * @param timeout Longest time to wait for the result.
+     *
+     * @tparam Id Identifier of the procedure.
+     *
+     * @return The result, or std::nullopt if the call could not be sent,
+     * failed or timed out.
+     */
+    template<auto Id>
+    auto Call(const Argument<Id>& argument, scheduling::Duration timeout)
+        -> std::optional<Result<Id>> {
+        AsyncValue<Outcome<Id>> outcome {};
+        const auto              ticket {Start<Id>(argument, outcome, timeout)};
+        if (!ticket) return std::nullopt;
+
+        // A failure is delivered too, so this returns as soon as one arrives
+        auto value {outcome.Wait(timeout)};
+        if (!value) {
+            // Once cancelled, a late result can no longer reach the value
+            Cancel(*ticket);
+            value = outcome();
+        }
+
+        if (!value || !value->get()) return std::nullopt;
+        return *value->get();
+    }
+
+    /**
+     * @brief Delivers the results and failures which arrive, and abandons
+     * calls which have timed out.
+     *
+     * Must be run repeatedly by one task on the calling core.
+     *
+     * @param timeout Longest time to wait for a result.
+     *
+     * @return Number of calls completed, whether or not they succeeded.
+     */
+    auto Service(scheduling::Duration timeout) -> std::size_t {
+        auto&       responses {m_link.Responses()};
+        std::size_t delivered {0};
+        for (const auto* frame {responses.Peek(timeout)}; frame;
+             frame = responses.TryPeek()) {
+            delivered += Complete(*frame) ? 1 : 0;
+            responses.Release();
+        }
+
+        Expire();
+        return delivered;
+    }
+
+    /**
+     * @brief Gets the counters of the client.
+     *
+     * @return Snapshot of the counters.
+     */
+    [[nodiscard]] auto Stats() -> RpcStats {
+        std::scoped_lock lock(m_lock);
+        return m_stats;
+    }
+
+  private:
+    /// Delivers a result payload, or a failure, to the receiver of a call.
+    using Deliver = auto (*)(
+        typename P::Receiver&, RpcStatus, std::span<const std::byte>
+    ) -> void;
+
+    struct Ticket {
+        std::uint16_t slot;
+        std::uint32_t sequence;
+    };
+
+    struct Pending {
+        std::uint32_t                       sequence {0};
+        scheduling::Clock::Instant          deadline {0};
+        // Set while the call is in flight
+        std::optional<typename P::Receiver> receiver {};
+    };
+
+    template<std::size_t I>
+    static auto DeliverAt(
+        typename P::Receiver& receiver, RpcStatus status,
+        std::span<const std::byte> payload
+    ) -> void {
+        if (status != RpcStatus::kOk) {
+            std::get<I>(receiver)(std::unexpected {status});
+            return;
+        }
+
+        typename P::template At<I>::Result result;
+        std::memcpy(&result, payload.data(), sizeof(result));
+        std::get<I>(receiver)(result);
+    }
+
+    /// Delivery of each procedure's result, indexed by position.
+    static constexpr auto kDeliver {[]<std::size_t... I>(
+                                        std::index_sequence<I...>
+                                    ) {
+        return std::array<Deliver, P::kCount> {&DeliverAt<I>...};
+    }(std::make_index_sequence<P::kCount> {})};
+
+    template<auto Id>
+    auto Start(
+        const Argument<Id>& argument, Callback<void, const Outcome<Id>&> done,
+        scheduling::Duration timeout
+    ) -> std::optional<Ticket> {
+        constexpr auto kIndex {P::template IndexOf<Id>()};
+
+        std::scoped_lock lock(m_lock);
+        auto&            requests {m_link.Requests()};
+        auto*            frame {requests.TryReserve()};
+        const auto       pending {std::ranges::find_if(
+            m_pending, [](const Pending& p) { return !p.receiver; }
+        )};
+        if (!frame || pending == m_pending.end()) {
+            ++m_stats.rejected;
+            return std::nullopt;
+        }
+
+        pending->sequence = ++m_sequence;
+        pending->deadline = scheduling::Clock::Now() + timeout;
+        pending->receiver.emplace(std::in_place_index<kIndex>, done);
+
+        const Ticket ticket {
+            .slot     = static_cast<std::uint16_t>(pending - m_pending.begin()),
+            .sequence = pending->sequence,
+        };
+        frame->procedure = kIndex;
+        frame->slot      = ticket.slot;
+        frame->sequence  = ticket.sequence;
+        frame->status    = RpcStatus::kOk;
+        std::memcpy(frame->payload.data(), &argument, sizeof(argument));
+        requests.Commit();
+
+        ++m_stats.calls;
+        return ticket;
+    }
+
+    /**
+     * @brief Delivers a response to its call, unless the call was abandoned.
+     */
+    auto Complete(const Frame& frame) -> bool {
+        std::scoped_lock lock(m_lock);
+        if (frame.slot >= MaxInFlight) return false;
+
+        auto& pending {m_pending[frame.slot]};
+        if (!pending.receiver || pending.sequence != frame.sequence)
+            return false;
+
+        // A result for another procedure means the cores were built with
+        // different protocols, so this one is not served
+        const auto index {pending.receiver->index()};
+        const auto status {
+            frame.procedure == index ? frame.status : RpcStatus::kUnbound
+        };
+        if (status != RpcStatus::kOk) ++m_stats.failed;
+        kDeliver[index](*pending.receiver, status, frame.payload);
+        pending.receiver.reset();
+        return true;
+    }
+
+    auto Cancel(Ticket ticket) -> void {
+        std::scoped_lock lock(m_lock);
+        auto&            pending {m_pending[ticket.slot]};
+        if (pending.receiver && pending.sequence == ticket.sequence) {
+            pending.receiver.reset();
+            ++m_stats.timeouts;
+        }
+    }
+
+    auto Expire() -> void {
+        std::scoped_lock lock(m_lock);
+        const auto       now {scheduling::Clock::Now()};
+        for (auto& pending : m_pending) {
+            if (pending.receiver && now >= pending.deadline) {
+                pending.receiver.reset();
+                ++m_stats.timeouts;
+            }
+        }
+    }
+
+    Link&                             m_link;
+    Mutex                             m_lock {};
+    std::array<Pending, MaxInFlight> m_pending {};
+    std::uint32_t                     m_sequence {0};
+    RpcStats                          m_stats {};
+};
+
+/**
+ * @brief Serves procedures called by the other core.
+ *
+ * Handlers are bound to procedures by identifier, then one task on the
+ * serving core runs \ref Serve. Requests are dispatched through a table
+ * generated from the protocol at compile time, indexed by the procedure's
+ * position, and each result is written straight into a response on the link.
+ *
+ * @code
+ * // CM7
+ * Fusion    fusion {};
+ * RpcServer server {g_offload};
+ * server.Bind<Service::kFuse>(OBC_CALLBACK_METHOD(fusion, Fuse));
+ * // ... with a task looping on server.Serve(...)
+ * @endcode
+ *
+ * @tparam Link The \ref RpcLink.
+ */
+template<typename Link>
+class RpcServer {
+    using P     = typename Link::Protocol;
+    using Frame = typename Link::Frame;
+
+    template<auto Id>
+    using Argument = typename P::template Find<Id>::Argument;
+    template<auto Id>
+    using Result = typename P::template Find<Id>::Result;
+
+  public:
+    /**
+     * @brief Creates a server with no handlers bound.
+     *
+     * @param link The link, which must outlive the server.
+     */
+    explicit RpcServer(Link& link) : m_link(link) {}
+
+    /**
+     * @brief Binds the handler of a procedure.
+     *
+     * Must not be called while \ref Serve is running.
+     *
+     * @param handler Called with each argument, returning the result.
+     *
+     * @tparam Id Identifier of the procedure.
+     */
+    template<auto Id>
+    auto Bind(Callback<Result<Id>, const Argument<Id>&> handler) -> void {
+        std::get<P::template IndexOf<Id>()>(m_handlers).emplace(handler);
+    }
+
+    /**
+     * @brief Handles the requests which arrive.
+     *
+     * Must be run repeatedly by one task on the serving core.
+     *
+     * @param timeout Longest time to wait for a request, and for space for
+     * each response.
+     *
+     * @return Number of requests handled.
+     */
+    auto Serve(scheduling::Duration timeout) -> std::size_t {
+        auto&       requests {m_link.Requests()};
+        std::size_t served {0};
+        for (const auto* request {requests.Peek(timeout)}; request;
+             request = requests.TryPeek()) {
+            // Without space for the response, the caller times out
+            if (auto* response {m_link.Responses().Reserve(timeout)}) {
+                response->procedure = request->procedure;
+                response->slot      = request->slot;
+                response->sequence  = request->sequence;
+                response->status =
+                    request->procedure < P::kCount
+                        ? kHandle[request->procedure](
+                              m_handlers, request->payload, response->payload
+                          )
+                        : RpcStatus::kUnbound;
+                m_link.Responses().Commit();
+                ++served;
+            }
+            requests.Release();
+        }
+        return served;
+    }
+
+  private:
+    /// Runs a handler on a request payload, writing the response payload.
+    using Handle = auto (*)(
+        typename P::Handlers&, std::span<const std::byte>, std::span<std::byte>
+    ) -> RpcStatus;
+
+    template<std::size_t I>
+    static auto HandleAt(
+        typename P::Handlers& handlers, std::span<const std::byte> in,
+        std::span<std::byte> out
+    ) -> RpcStatus {
+        auto& handler {std::get<I>(handlers)};
+        if (!handler) return RpcStatus::kUnbound;
+
+        typename P::template At<I>::Argument argument;
+        std::memcpy(&argument, in.data(), sizeof(argument));
+        const auto result {(*handler)(argument)};
+        std::memcpy(out.data(), &result, sizeof(result));
+        return RpcStatus::kOk;
+    }
+
+    /// Dispatch of each procedure, indexed by position.
+    static constexpr auto kHandle {[]<std::size_t... I>(
+                                       std::index_sequence<I...>
+                                   ) {
+        return std::array<Handle, P::kCount> {&HandleAt<I>...};
+    }(std::make_index_sequence<P::kCount> {})};
+
+    Link&                m_link;
+    typename P::Handlers m_handlers {};
+};
+}  // namespace obc::ipc
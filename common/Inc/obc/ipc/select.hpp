@@ -0,0 +1,206 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "obc/ipc/callback.hpp"
+#include "obc/scheduling/delay.hpp"
+#include "obc/utils/meta.hpp"
+
+namespace obc::ipc {
+/**
+ * @brief A source which can wake a task when it becomes ready, such as an
+ * \ref AsyncValue.
+ *
+ * Calling the source yields an option type which holds a value once the
+ * source is ready.
+ */
+template<typename S>
+concept Subscribable = requires(S& s, scheduling::Notification waiter) {
+    { s() } -> obc::utils::OptionLikeAny;
+    s.Subscribe(waiter);
+    s.Unsubscribe();
+};
+
+/**
+ * @brief A source which \ref WaitAny and \ref WaitAll can block on.
+ */
+template<typename S>
+concept WaitSource =
+    Subscribable<S> || std::same_as<std::remove_cv_t<S>, scheduling::Timeout>;
+
+namespace detail {
+template<typename S>
+constexpr bool kIsTimeout =
+    std::same_as<std::remove_cv_t<S>, scheduling::Timeout>;
+
+template<WaitSource S>
+auto IsReady(S& source) -> bool {
+    if constexpr (kIsTimeout<S>) {
+        return static_cast<bool>(source);
+    } else {
+        return source().has_value();
+    }
+}
+
+/**
+ * @brief Gets the earliest deadline of the timeouts among the sources.
+ */
+template<WaitSource... S>
+auto EarliestDeadline(S&... sources) -> scheduling::Clock::Instant {
+    auto earliest {std::numeric_limits<scheduling::Clock::Instant>::max()};
+    const auto visit {[&]<typename T>(T& source) {
+        if constexpr (kIsTimeout<T>)
+            earliest = std::min(earliest, source.Deadline());
+    }};
+    (visit(sources), ...);
+    return earliest;
+}
+
+/**
+ * @brief Registers the calling task with every subscribable source for the
+ * lifetime of the guard.
+ */
+template<WaitSource... S>
+class Subscription {
+  public:
+    explicit Subscription(S&... sources) : m_sources(sources...) {
+        const auto waiter {scheduling::Notification::Current()};
+        const auto subscribe {[&]<typename T>(T& source) {
+            if constexpr (!kIsTimeout<T>) source.Subscribe(waiter);
+        }};
+        (subscribe(sources), ...);
+    }
+
+    Subscription(const Subscription&)                    = delete;
+    Subscription(Subscription&&)                         = delete;
+    auto operator=(const Subscription&) -> Subscription& = delete;
+    auto operator=(Subscription&&) -> Subscription&      = delete;
+
+    ~Subscription() {
+        std::apply(
+            [](auto&... sources) { (Unsubscribe(sources), ...); }, m_sources
+        );
+    }
+
+  private:
+    template<typename T>
+    static auto Unsubscribe(T& source) -> void {
+        if constexpr (!kIsTimeout<T>) source.Unsubscribe();
+    }
+
+    std::tuple<S&...> m_sources;
+};
+}  // namespace detail
+
+/**
+ * @brief Blocks the calling task until any of several sources is ready.
+ *
+ * Sources are \ref AsyncValue "AsyncValues" (including those bound as bus
+ * listeners, which capture the next message) and \ref scheduling::Timeout
+ * "Timeouts". The task sleeps on its wait notification, which the values give
+ * when they are set, until the earliest timeout, so it runs again as soon as
+ * the first source is ready.
+ *
+ * @code
+ * AsyncValue<Reading> imu {};
+ * AsyncValue<Reading> baro {};
+ * RequestImu(imu);
+ * RequestBaro(baro);
+ *
+ * Timeout timeout {units::milliseconds<float>(20)};
+ * switch (WaitAny(imu, baro, timeout)) { ... }
+ * @endcode
+ *
+ * At least one source must be a timeout, so that every wait is bounded. Each
+ * value may only be waited on by one task at a time.
+ *
+ * @param sources The sources.
+ *
+ * @return Index of the first ready source in argument order. When several are
+ * ready, the earliest argument wins.
+ */
+template<WaitSource... S>
+auto WaitAny(S&... sources) -> std::size_t {
+    static_assert(
+        (detail::kIsTimeout<S> || ...), "At least one source must be a timeout"
+    );
+
+    const auto first_ready {[&] -> std::optional<std::size_t> {
+        std::optional<std::size_t> first {};
+        std::size_t                index {0};
+        const auto                 check {[&](auto& source) {
+            if (!first && detail::IsReady(source)) first = index;
+            ++index;
+        }};
+        (check(sources), ...);
+        return first;
+    }};
+
+    const detail::Subscription<S...> subscription(sources...);
+    auto deadline {scheduling::Timeout::Until(
+        detail::EarliestDeadline(sources...)
+    )};
+    if (auto fired {deadline.Poll(first_ready, scheduling::wait::Notify {})})
+        return *fired;
+
+    // The earliest timeout has now elapsed
+    return *first_ready();
+}
+
+/**
+ * @brief Blocks the calling task until every value is ready, or until any
+ * timeout elapses.
+ *
+ * Takes the same sources as \ref WaitAny, and likewise needs at least one
+ * timeout.
+ *
+ * @param sources The sources.
+ *
+ * @return True if every value became ready before a timeout elapsed.
+ */
+template<WaitSource... S>
+auto WaitAll(S&... sources) -> bool {
+    static_assert(
+        (detail::kIsTimeout<S> || ...), "At least one source must be a timeout"
+    );
+
+    const auto all_ready {[&] {
+        const auto ready {[]<typename T>(T& source) {
+            return detail::kIsTimeout<T> || detail::IsReady(source);
+        }};
+        return (ready(sources) && ...);
+    }};
+
+    const detail::Subscription<S...> subscription(sources...);
+    auto deadline {scheduling::Timeout::Until(
+        detail::EarliestDeadline(sources...)
+    )};
+    return deadline.Poll(all_ready, scheduling::wait::Notify {});
+}
+}  // namespace obc::ipc
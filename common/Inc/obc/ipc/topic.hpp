@@ -0,0 +1,566 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/ipc/queue.hpp"
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::ipc {
+template<typename S>
+class Topic;
+
+/**
+ * @brief A fixed pool of reference-counted buffers.
+ *
+ * A buffer is written through a \ref Loan, which is the only reference to it,
+ * and is then shared as any number of read-only \ref Sample references. The
+ * buffer returns to the pool when the last reference is dropped, so one
+ * payload reaches many readers without being copied.
+ *
+ * @tparam T Type of payload.
+ * @tparam N Number of buffers, a power of two.
+ */
+template<typename T, std::size_t N>
+class SamplePool {
+    struct Slot;
+
+  public:
+    /**
+     * @brief Shared read-only reference to a buffer.
+     */
+    class Sample {
+      public:
+        Sample() = default;
+
+        Sample(const Sample& other)
+            : m_pool(other.m_pool), m_index(other.m_index) {
+            if (m_pool) m_pool->Retain(m_index);
+        }
+
+        Sample(Sample&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr)),
+              m_index(other.m_index) {}
+
+        auto operator=(Sample other) noexcept -> Sample& {
+            std::swap(m_pool, other.m_pool);
+            std::swap(m_index, other.m_index);
+            return *this;
+        }
+
+        ~Sample() {
+            if (m_pool) m_pool->Release(m_index);
+        }
+
+        auto operator*() const -> const T& { return m_pool->At(m_index); }
+
+        auto operator->() const -> const T* { return &**this; }
+
+        explicit operator bool() const { return m_pool != nullptr; }
+
+      private:
+        friend SamplePool;
+        template<typename>
+        friend class Topic;
+
+        /**
+         * @brief Adopts a reference which has already been counted.
+         */
+        Sample(SamplePool& pool, std::uint32_t index)
+            : m_pool(&pool), m_index(index) {}
+
+        SamplePool*   m_pool {nullptr};
+        std::uint32_t m_index {0};
+    };
+
+    /**
+     * @brief Exclusive writable reference to a buffer which has not yet been
+     * shared.
+     */
+    class Loan {
+      public:
+        Loan(const Loan&)                    = delete;
+        auto operator=(const Loan&) -> Loan& = delete;
+
+        Loan(Loan&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr)),
+              m_index(other.m_index) {}
+
+        auto operator=(Loan&& other) noexcept -> Loan& {
+            std::swap(m_pool, other.m_pool);
+            std::swap(m_index, other.m_index);
+            return *this;
+        }
+
+        ~Loan() {
+            if (m_pool) m_pool->Release(m_index);
+        }
+
+        auto operator*() const -> T& { return m_pool->At(m_index); }
+
+        auto operator->() const -> T* { return &**this; }
+
+        /**
+         * @brief Gives up write access, turning the loan into a shared sample.
+         *
+         * @return Sample referring to the same buffer.
+         */
+        auto Share() && -> Sample {
+            return {*std::exchange(m_pool, nullptr), m_index};
+        }
+
+      private:
+        friend SamplePool;
+
+        Loan(SamplePool& pool, std::uint32_t index)
+            : m_pool(&pool), m_index(index) {}
+
+        SamplePool*   m_pool {nullptr};
+        std::uint32_t m_index {0};
+    };
+
+    SamplePool() {
+        for (std::uint32_t i {0}; i < N; ++i) m_free.TryPush(i);
+    }
+
+    SamplePool(const SamplePool&)                    = delete;
+    SamplePool(SamplePool&&)                         = delete;
+    auto operator=(const SamplePool&) -> SamplePool& = delete;
+    auto operator=(SamplePool&&) -> SamplePool&      = delete;
+    ~SamplePool()                                    = default;
+
+    /**
+     * @brief Takes a free buffer for writing.
+     *
+     * The buffer still holds whichever payload was last written to it.
+     *
+     * @return The buffer, or std::nullopt if every buffer is referenced.
+     */
+    auto Take() -> std::optional<Loan> {
+        const auto index {m_free.TryPop()};
+        if (!index) return std::nullopt;
+
+        m_slots[*index].refs.store(1, std::memory_order_relaxed);
+        return Loan {*this, *index};
+    }
+
+    /**
+     * @brief Gets the number of buffers which are not referenced.
+     *
+     * @return The number of buffers, only a snapshot while other tasks are
+     * using the pool.
+     */
+    [[nodiscard]] auto Available() const -> std::size_t {
+        return m_free.Size();
+    }
+
+  private:
+    template<typename>
+    friend class Topic;
+
+    struct Slot {
+        std::atomic<std::uint32_t> refs {0};
+        T                          value {};
+    };
+
+    auto At(std::uint32_t index) -> T& { return m_slots[index].value; }
+
+    auto Retain(std::uint32_t index) -> void {
+        m_slots[index].refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto Release(std::uint32_t index) -> void {
+        // The last reader's accesses must happen before the next writer's
+        if (m_slots[index].refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            m_free.TryPush(index);
+    }
+
+    std::array<Slot, N>         m_slots {};
+    MpmcQueue<std::uint32_t, N> m_free {};
+};
+
+/**
+ * @brief How a topic delivers samples to its subscribers.
+ */
+enum class Delivery : std::uint8_t {
+    /// Subscribers see only the most recent sample, as for sensor readings.
+    kLatest,
+    /// Each subscriber receives every sample in order, as for events.
+    kQueued,
+};
+
+/**
+ * @brief Compile-time description of a topic.
+ *
+ * @tparam Id Identifier of the topic, unique within a \ref Broker.
+ * @tparam T Type of payload.
+ * @tparam D How samples are delivered.
+ * @tparam Samples Number of buffers in the topic's pool, a power of two. Every
+ * sample held by a subscriber or waiting in a queue takes one.
+ * @tparam Subscribers Most subscribers at once.
+ * @tparam Depth Length of each subscriber's queue for queued topics, a power
+ * of two.
+ */
+template<
+    auto Id, typename T, Delivery D, std::size_t Samples = 8,
+    std::size_t Subscribers = 4, std::size_t Depth = 4>
+struct TopicSpec {
+    static constexpr auto        kId          = Id;
+    static constexpr Delivery    kDelivery    = D;
+    static constexpr std::size_t kSamples     = Samples;
+    static constexpr std::size_t kSubscribers = Subscribers;
+    static constexpr std::size_t kDepth       = Depth;
+
+    using Type = T;
+};
+
+/**
+ * @brief Counters of a topic, which show where samples are lost.
+ */
+struct TopicStats {
+    /// Samples published.
+    std::uint32_t published;
+    /// Samples which never reached a subscriber, because the pool was
+    /// exhausted when publishing or a subscriber's queue was full.
+    std::uint32_t dropped;
+};
+
+/**
+ * @brief A typed channel from any number of publishers to a fixed number of
+ * subscribers.
+ *
+ * Payloads are written directly into a buffer loaned from the topic's pool and
+ * every subscriber reads that same buffer, so publishing never copies the
+ * payload. Unlike the span given to a bus listener, a sample stays valid for as
+ * long as it is held.
+ *
+ * @code
+ * Topic<ImuSpec> imu {};
+ *
+ * // Sensor task
+ * if (auto loan {imu.Loan()}) {
+ *     ReadInto(**loan);
+ *     imu.Publish(std::move(*loan));
+ * }
+ *
+ * // Any number of consumer tasks
+ * auto sub {*imu.Subscribe()};
+ * if (auto sample {sub.Poll()}) Fuse(*sample);
+ * @endcode
+ *
+ * @note Publishing and subscribing take a \ref SpinLock for a few
+ * instructions per subscriber, so must not happen from interrupts.
+ *
+ * @tparam S Specification of the topic, see \ref TopicSpec.
+ */
+template<typename S>
+class Topic {
+    using T = typename S::Type;
+
+  public:
+    using Pool   = SamplePool<T, S::kSamples>;
+    using Sample = typename Pool::Sample;
+    using Loaned = typename Pool::Loan;
+
+    /**
+     * @brief A registration to receive samples from a topic.
+     *
+     * Unsubscribes when destroyed, releasing any samples still queued for it.
+     */
+    class Subscriber {
+      public:
+        Subscriber(const Subscriber&)                    = delete;
+        auto operator=(const Subscriber&) -> Subscriber& = delete;
+
+        Subscriber(Subscriber&& other) noexcept
+            : m_topic(std::exchange(other.m_topic, nullptr)),
+              m_index(other.m_index), m_seen(other.m_seen) {}
+
+        auto operator=(Subscriber&& other) noexcept -> Subscriber& {
+            std::swap(m_topic, other.m_topic);
+            std::swap(m_index, other.m_index);
+            std::swap(m_seen, other.m_seen);
+            return *this;
+        }
+
+        ~Subscriber() {
+            if (m_topic) m_topic->Unsubscribe(m_index);
+        }
+
+        /**
+         * @brief Takes the next sample without blocking.
+         *
+         * For latest-value topics, this is the most recent sample if it has
+         * not been returned before.
+         *
+         * @return The sample, or std::nullopt if there is no new sample.
+         */
+        auto Poll() -> std::optional<Sample> {
+            if constexpr (S::kDelivery == Delivery::kLatest) {
+                return m_topic->TakeLatest(m_seen);
+            } else {
+                const auto index {m_topic->m_queues[m_index].TryPop()};
+                if (!index) return std::nullopt;
+                return Sample {m_topic->m_pool, *index};
+            }
+        }
+
+        /**
+         * @brief Takes the next sample from a queued topic, waiting for one
+         * if necessary.
+         *
+         * @param timeout Longest time to wait.
+         *
+         * @return The sample, or std::nullopt if none arrived in time.
+         */
+        auto Pop(scheduling::Duration timeout) -> std::optional<Sample>
+            requires(S::kDelivery == Delivery::kQueued)
+        {
+            const auto index {m_topic->m_queues[m_index].Pop(timeout)};
+            if (!index) return std::nullopt;
+            return Sample {m_topic->m_pool, *index};
+        }
+
+      private:
+        friend Topic;
+
+        Subscriber(Topic& topic, std::size_t index)
+            : m_topic(&topic), m_index(index) {}
+
+        Topic*        m_topic {nullptr};
+        std::size_t   m_index {0};
+        // Sequence number of the last latest-value sample returned
+        std::uint32_t m_seen {0};
+    };
+
+    Topic()                                = default;
+    Topic(const Topic&)                    = delete;
+    Topic(Topic&&)                         = delete;
+    auto operator=(const Topic&) -> Topic& = delete;
+    auto operator=(Topic&&) -> Topic&      = delete;
+    ~Topic()                               = default;
+
+    /**
+     * @brief Takes a buffer from the topic's pool to write the next sample
+     * into.
+     *
+     * @return The buffer, or std::nullopt if the pool is exhausted, which is
+     * counted as a drop.
+     */
+    auto Loan() -> std::optional<Loaned> {
+        auto loan {m_pool.Take()};
+        if (!loan) m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return loan;
+    }
+
+    /**
+     * @brief Delivers a sample to every subscriber.
+     *
+     * @param loan Buffer holding the sample, from \ref Loan.
+     */
+    auto Publish(Loaned&& loan) -> void {
+        Sample sample {std::move(loan).Share()};
+        m_published.fetch_add(1, std::memory_order_relaxed);
+
+        if constexpr (S::kDelivery == Delivery::kLatest) {
+            {
+                std::scoped_lock lock(m_lock);
+                std::swap(m_latest, sample);
+                ++m_sequence;
+            }
+            // The previous sample is released outside the lock
+        } else {
+            std::scoped_lock lock(m_lock);
+            for (std::size_t i {0}; i < S::kSubscribers; ++i) {
+                if (!m_subscribed[i]) continue;
+
+                // The queued index carries a reference of its own
+                m_pool.Retain(sample.m_index);
+                if (!m_queues[i].TryPush(sample.m_index)) {
+                    m_pool.Release(sample.m_index);
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Copies a value into a buffer and publishes it.
+     *
+     * @param value The value.
+     *
+     * @return False if the pool was exhausted.
+     */
+    auto Publish(const T& value) -> bool {
+        auto loan {Loan()};
+        if (!loan) return false;
+
+        **loan = value;
+        Publish(std::move(*loan));
+        return true;
+    }
+
+    /**
+     * @brief Registers a new subscriber.
+     *
+     * A subscriber to a latest-value topic immediately sees the most recent
+     * sample, if any. A subscriber to a queued topic receives only samples
+     * published after it subscribed.
+     *
+     * @return The subscriber, or std::nullopt if there are already
+     * `Subscribers` subscribers.
+     */
+    auto Subscribe() -> std::optional<Subscriber> {
+        std::scoped_lock lock(m_lock);
+        for (std::size_t i {0}; i < S::kSubscribers; ++i) {
+            if (m_subscribed[i]) continue;
+
+            m_subscribed[i] = true;
+            return Subscriber {*this, i};
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Gets the counters of the topic.
+     *
+     * @return Snapshot of the counters.
+     */
+    [[nodiscard]] auto Stats() const -> TopicStats {
+        return {
+            .published = m_published.load(std::memory_order_relaxed),
+            .dropped   = m_dropped.load(std::memory_order_relaxed),
+        };
+    }
+
+  private:
+    auto TakeLatest(std::uint32_t& seen) -> std::optional<Sample> {
+        std::scoped_lock lock(m_lock);
+        if (!m_latest || m_sequence == seen) return std::nullopt;
+
+        seen = m_sequence;
+        return m_latest;
+    }
+
+    auto Unsubscribe(std::size_t index) -> void {
+        // The queue is drained under the lock too, or a new subscriber could
+        // take the index and lose samples published to it in the meantime
+        std::scoped_lock lock(m_lock);
+        m_subscribed[index] = false;
+
+        if constexpr (S::kDelivery == Delivery::kQueued) {
+            while (const auto queued {m_queues[index].TryPop()})
+                m_pool.Release(*queued);
+        }
+    }
+
+    // Latest-value topics need no queues
+    static constexpr std::size_t kQueues =
+        S::kDelivery == Delivery::kQueued ? S::kSubscribers : 0;
+
+    Pool                                                     m_pool {};
+    SpinLock                                                 m_lock {};
+    std::array<bool, S::kSubscribers>                        m_subscribed {};
+    std::array<MpmcQueue<std::uint32_t, S::kDepth>, kQueues> m_queues {};
+    // Latest-value topics only, guarded by m_lock and released before m_pool
+    Sample                                                   m_latest {};
+    std::uint32_t                                            m_sequence {0};
+    std::atomic<std::uint32_t>                               m_published {0};
+    std::atomic<std::uint32_t>                               m_dropped {0};
+};
+
+/**
+ * @brief A fixed set of topics, looked up by their identifiers at compile
+ * time.
+ *
+ * @code
+ * enum class TopicId : std::uint8_t { kImu, kGps, kEvents };
+ *
+ * Broker<
+ *     TopicSpec<TopicId::kImu, ImuReading, Delivery::kLatest>,
+ *     TopicSpec<TopicId::kGps, GpsFix, Delivery::kLatest>,
+ *     TopicSpec<TopicId::kEvents, Event, Delivery::kQueued, 16>>
+ *     g_broker {};
+ *
+ * g_broker.Get<TopicId::kGps>().Publish(fix);
+ * @endcode
+ *
+ * @tparam Specs Specification of each topic, whose identifiers must all have
+ * the same type.
+ */
+template<typename... Specs>
+class Broker {
+  public:
+    /**
+     * @brief Gets a topic by its identifier.
+     *
+     * @tparam Id Identifier of the topic.
+     *
+     * @return The topic.
+     */
+    template<auto Id>
+    auto Get() -> auto& {
+        return std::get<IndexOf<Id>()>(m_topics);
+    }
+
+    /**
+     * @brief Calls a function with the identifier and counters of every
+     * topic, for reporting in telemetry.
+     *
+     * @param f Function taking an identifier and a \ref TopicStats.
+     */
+    template<typename F>
+    auto VisitStats(F&& f) const -> void {
+        std::apply(
+            [&](const auto&... topics) {
+                (f(Specs::kId, topics.Stats()), ...);
+            },
+            m_topics
+        );
+    }
+
+  private:
+    template<auto Id>
+    static consteval auto IndexOf() -> std::size_t {
+        constexpr std::array<bool, sizeof...(Specs)> kMatches {
+            (Specs::kId == Id)...
+        };
+        static_assert(
+            std::ranges::count(kMatches, true) == 1,
+            "Topic identifiers must be unique"
+        );
+        return std::ranges::find(kMatches, true) - kMatches.begin();
+    }
+
+    std::tuple<Topic<Specs>...> m_topics {};
+};
+}  // namespace obc::ipc
@@ -20,89 +20,192 @@
 
 #pragma once
 
-#include <gmock/gmock.h>
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
 
-#include "obc/bus.hpp"
+#include "obc/bus/types.hpp"
+#include "obc/ipc/callback.hpp"
+#include "obc/utils/error.hpp"
 
 /**
  * @brief Mocks for communication busses.
  *
- * Use \ref TypeAmalgam to create a bus which satisfies multiple concepts.
+ * Each mock implements one bus concept, with the bus' side of each operation
+ * driven by the test.
  */
 namespace obc::bus::mock {
-/**
- * @brief Mock of \ref SendBus.
- *
- * @tparam M The type of message to send.
- */
-template<Message M = BasicMessage>
-class MockSendBus {
-  public:
-    MOCK_METHOD(void, Send, (const M& msg));
-};
-
 /**
  * @brief Mock of \ref ListenBus.
  *
  * @tparam M The type of message received.
+ * @tparam Capacity Most listeners registered at once.
  */
-template<Message M = BasicMessage>
-class MockListenBus : public ListenBusMixin<M> {
+template<Message M = BasicMessage, std::size_t Capacity = 4>
+class MockListenBus {
   public:
+    using ListenDispatchError = utils::Never;
+    using ListenCallbackError = utils::Never;
+    using ListenCallback =
+        ipc::Callback<void, const std::expected<M, ListenCallbackError>&>;
+    using FilterCallback =
+        ipc::Callback<bool, const std::expected<M, ListenCallbackError>&>;
+
+    /**
+     * @brief Keeps a listener registered until destroyed.
+     */
+    class ListenHandle {
+      public:
+        ListenHandle(MockListenBus& bus, std::size_t index)
+            : m_bus(&bus), m_index(index) {}
+
+        ListenHandle(ListenHandle&& other) noexcept
+            : m_bus(std::exchange(other.m_bus, nullptr)),
+              m_index(other.m_index) {}
+
+        auto operator=(ListenHandle&& other) noexcept -> ListenHandle& {
+            std::swap(m_bus, other.m_bus);
+            std::swap(m_index, other.m_index);
+            return *this;
+        }
+
+        ListenHandle(const ListenHandle&)                    = delete;
+        auto operator=(const ListenHandle&) -> ListenHandle& = delete;
+
+        ~ListenHandle() {
+            if (m_bus) m_bus->m_listeners.at(m_index).reset();
+        }
+
+      private:
+        MockListenBus* m_bus;
+        std::size_t    m_index;
+    };
+
+    /**
+     * @brief Adds a listener to be notified upon receiving a message.
+     *
+     * @param cb The listener callback to add.
+     *
+     * @return A handle which must be retained for the listener to remain
+     * active.
+     */
+    auto Listen(ListenCallback&& cb)
+        -> std::expected<ListenHandle, ListenDispatchError> {
+        return Add({std::move(cb), std::nullopt});
+    }
+
+    /**
+     * @brief Adds a listener to be notified of messages matching a filter.
+     *
+     * @param cb The listener callback to add.
+     * @param flt Filter which messages must match.
+     *
+     * @return A handle which must be retained for the listener to remain
+     * active.
+     */
+    auto Listen(ListenCallback&& cb, FilterCallback&& flt)
+        -> std::expected<ListenHandle, ListenDispatchError> {
+        return Add({std::move(cb), std::move(flt)});
+    }
+
     /**
      * @brief Forwards a message to all listeners.
      *
      * @param msg The message to be forwarded.
      */
-    void PushListenMessage(const M& msg) { FeedListeners(msg); }
-};
+    auto PushListenMessage(const M& msg) -> void {
+        const std::expected<M, ListenCallbackError> received {msg};
+        // Listeners may be removed by the callbacks
+        auto listeners {m_listeners};
+        for (auto& listener : listeners) {
+            if (!listener) continue;
+            if (listener->filter && !(*listener->filter)(received)) continue;
+            listener->callback(received);
+        }
+    }
 
-/**
- * @brief Mock of \ref RequestBus.
- *
- * @tparam Req The type of message sent to request data.
- * @tparam Res The type of message received in response.
- * @tparam Flt The object used to determine if an incoming message is a response
- * to a given request.
- * @tparam BufUnit Smallest addressable unit of data within an incoming message.
- * @tparam Buf The type of the buffer which the result of a request is sent to.
- */
-template<
-    Message Req = BasicMessage, Message Res = BasicMessage,
-    MessageFilter<Res> Flt     = ipc::Callback<bool, const Res&>,
-    std::semiregular   BufUnit = std::byte,
-    Buffer<BufUnit>    Buf     = std::span<BufUnit>>
-class MockRequestBus : public RequestBusMixin<
-                           MockRequestBus<Req, Res, Flt, BufUnit, Buf>, Req,
-                           Res, Flt, BufUnit, Buf> {
-  public:
     /**
-     * @brief Forwards a message to all pending requests.
+     * @brief Gets the number of registered listeners.
      *
-     * @param res The response message to forward.
+     * @return The number of listeners.
      */
-    void PushRequestResponse(const Res& res) { FeedRequesters(res); }
+    [[nodiscard]] auto Listeners() const -> std::size_t {
+        std::size_t count {0};
+        for (const auto& listener : m_listeners)
+            if (listener) ++count;
+        return count;
+    }
+
+  private:
+    struct Listener {
+        ListenCallback                callback;
+        std::optional<FilterCallback> filter;
+    };
 
-    MOCK_METHOD(Flt, IssueRequest, (const Req& req));
+    auto Add(Listener listener) -> ListenHandle {
+        for (std::size_t i {0}; i < m_listeners.size(); ++i) {
+            if (m_listeners.at(i)) continue;
+            m_listeners.at(i).emplace(std::move(listener));
+            return ListenHandle(*this, i);
+        }
+        // Tests must not register more listeners than they make room for
+        std::terminate();
+    }
+
+    std::array<std::optional<Listener>, Capacity> m_listeners {};
 };
 
 /**
- * @brief Mock of \ref ProcessBus.
+ * @brief Mock of \ref SendBus.
+ *
+ * Sends are recorded and only complete when the test says so, unless
+ * \ref complete_immediately is set.
  *
- * @tparam Req The type of message received that requests data.
- * @tparam Res The type of message sent in response.
+ * @tparam M The type of message to send.
  */
-template<Message Req = BasicMessage, Message Res = BasicMessage>
-class MockProcessBus
-    : public ProcessBusMixin<MockProcessBus<Req, Res>, Req, Res> {
+template<Message M = BasicMessage>
+class MockSendBus {
   public:
+    using SendHandle        = std::monostate;
+    using SendDispatchError = utils::Never;
+    using SendCallbackError = utils::Never;
+    using SendCallback =
+        ipc::Callback<void, const std::expected<M, SendCallbackError>&>;
+
     /**
-     * @brief Forwards a message to processors.
+     * @brief Records a message as sent.
+     *
+     * @param msg The message to send.
+     * @param cb Invoked once the send completes.
      *
-     * @param req The request message to forward.
+     * @return An empty handle.
+     */
+    auto Send(const M& msg, SendCallback&& cb)
+        -> std::expected<SendHandle, SendDispatchError> {
+        sent.push_back(msg);
+        m_pending.emplace_back(msg, std::move(cb));
+        if (complete_immediately) CompleteSends();
+        return SendHandle {};
+    }
+
+    /**
+     * @brief Completes every send which has not yet completed.
      */
-    void PushProcessResponse(const Res& res) { FeedProcessors(res); }
+    auto CompleteSends() -> void {
+        auto pending {std::exchange(m_pending, {})};
+        for (auto& [msg, cb] : pending) cb(msg);
+    }
+
+    /// Every message sent, in order.
+    std::vector<M> sent {};
+    /// Completes sends from within \ref Send.
+    bool           complete_immediately {false};
 
-    MOCK_METHOD(void, IssueResponse, (const Req& req, const Res& res));
+  private:
+    std::vector<std::pair<M, SendCallback>> m_pending {};
 };
 }  // namespace obc::bus::mock
@@ -0,0 +1,195 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "obc/scheduling/delay.hpp"
+
+/**
+ * @brief Compile-time schedulability analysis of fixed priority task sets.
+ *
+ * Each task declares its timing requirements up front. Priorities are then
+ * assigned rate-monotonically (shorter periods, or deadlines if constrained,
+ * run at higher priorities) and a response-time analysis checks that every
+ * task completes before its deadline, even when all tasks are released at
+ * once.
+ *
+ * @code
+ * using FlightTasks = TaskSet<
+ *     TaskSpec {.period = 1'000, .budget = 200, .stack_depth = 1024},
+ *     TaskSpec {.period = 100'000, .budget = 5'000}>;
+ *
+ * class CanTask : public ScheduledTask<FlightTasks, 0> { ... };
+ * @endcode
+ *
+ * The analysis assumes independent tasks on one core, ignoring kernel
+ * overhead and blocking on shared resources, so budgets should include a
+ * margin for both.
+ */
+namespace obc::scheduling {
+/**
+ * @brief Timing requirements of a periodic task.
+ *
+ * All times are in microseconds.
+ */
+struct TaskSpec {
+    /// Time between releases.
+    Clock::Instant period {0};
+    /// Worst case execution time of a single run.
+    Clock::Instant budget {0};
+    /// Time after its release by which a run must complete, or 0 to use the
+    /// period.
+    Clock::Instant deadline {0};
+    /// Stack depth of the task in words.
+    std::uint32_t  stack_depth {4096};
+
+    /**
+     * @brief Gets the effective deadline of the task.
+     *
+     * @return The deadline, defaulting to the period.
+     */
+    [[nodiscard]] constexpr auto Deadline() const -> Clock::Instant {
+        return deadline ? deadline : period;
+    }
+};
+
+/**
+ * @brief Results of analysing a set of tasks.
+ *
+ * @tparam N Number of tasks.
+ */
+template<std::size_t N>
+struct TaskSetAnalysis {
+    /// Priority rank of each task, where 0 is the highest priority.
+    std::array<std::size_t, N>                   ranks {};
+    /// Worst case response time of each task, or std::nullopt if it can
+    /// exceed the deadline.
+    std::array<std::optional<Clock::Instant>, N> response_times {};
+    /// Fraction of the processor used by the task set, in parts per million.
+    std::uint64_t                                utilization {0};
+
+    /**
+     * @brief Checks if every task meets its deadline.
+     *
+     * @return True if the task set is schedulable.
+     */
+    [[nodiscard]] constexpr auto Schedulable() const -> bool {
+        return std::ranges::all_of(response_times, [](const auto& r) {
+            return r.has_value();
+        });
+    }
+};
+
+/**
+ * @brief Assigns priorities to and analyses a set of tasks.
+ *
+ * Tasks with equal deadlines are ranked in the order given. Response times
+ * are found by iterating
+ * \f$R_i = C_i + \sum_{j \in hp(i)} \lceil R_i / T_j \rceil C_j\f$ to a fixed
+ * point, which is exact for deadlines no longer than periods.
+ *
+ * @param tasks The task set.
+ *
+ * @return The priority assignment and response times.
+ */
+template<std::size_t N>
+constexpr auto Analyse(const std::array<TaskSpec, N>& tasks)
+    -> TaskSetAnalysis<N> {
+    TaskSetAnalysis<N> result {};
+
+    // Insertion sort by deadline, as std::stable_sort is not constexpr
+    std::array<std::size_t, N> order {};
+    for (std::size_t i {0}; i < N; ++i) {
+        auto j {i};
+        for (; j > 0 && tasks.at(order.at(j - 1)).Deadline() >
+                            tasks.at(i).Deadline();
+             --j)
+            order.at(j) = order.at(j - 1);
+        order.at(j) = i;
+    }
+    for (std::size_t rank {0}; rank < N; ++rank)
+        result.ranks.at(order.at(rank)) = rank;
+
+    for (const auto& task : tasks)
+        result.utilization += task.budget * 1'000'000 / task.period;
+
+    for (std::size_t rank {0}; rank < N; ++rank) {
+        const auto& task {tasks.at(order.at(rank))};
+
+        Clock::Instant response {task.budget};
+        while (response <= task.Deadline()) {
+            Clock::Instant demand {task.budget};
+            for (std::size_t higher {0}; higher < rank; ++higher) {
+                const auto& other {tasks.at(order.at(higher))};
+                demand +=
+                    (response + other.period - 1) / other.period * other.budget;
+            }
+
+            if (demand == response) break;
+            response = demand;
+        }
+
+        if (response <= task.Deadline())
+            result.response_times.at(order.at(rank)) = response;
+    }
+
+    return result;
+}
+
+/**
+ * @brief A set of tasks whose schedulability is checked at compile time.
+ *
+ * Fails to compile if any task can miss its deadline.
+ *
+ * @tparam Specs Timing requirements of each task.
+ */
+template<TaskSpec... Specs>
+class TaskSet {
+  public:
+    /// Number of tasks in the set.
+    static constexpr std::size_t kSize = sizeof...(Specs);
+    /// Timing requirements of each task.
+    static constexpr std::array<TaskSpec, kSize> kTasks {Specs...};
+    /// Priority assignment and response times.
+    static constexpr TaskSetAnalysis<kSize> kAnalysis {Analyse(kTasks)};
+
+    static_assert(
+        std::ranges::all_of(
+            kTasks,
+            [](const TaskSpec& task) {
+                return task.period > 0 && task.Deadline() <= task.period;
+            }
+        ),
+        "Tasks must have a period and a deadline no longer than it"
+    );
+    static_assert(
+        kAnalysis.utilization <= 1'000'000, "Task set overloads the processor"
+    );
+    static_assert(
+        kAnalysis.Schedulable(), "A task in the set can miss its deadline"
+    );
+};
+}  // namespace obc::scheduling
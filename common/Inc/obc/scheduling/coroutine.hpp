@@ -0,0 +1,548 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <units/time.h>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+#include "obc/scheduling/task.hpp"
+
+/**
+ * @brief Cooperative coroutines which share the stack of a single task.
+ *
+ * Each task reserves a stack for its worst case call depth, which is wasteful
+ * for the many small state machines (such as sensor drivers) that spend almost
+ * all of their time waiting. Instead, these can be written as coroutines run by
+ * an executor. Only the state which lives across a suspension point is kept
+ * (in the coroutine frame), and frames are allocated from a fixed pool owned
+ * by the executor rather than the heap.
+ *
+ * @code
+ * auto Blink(Executor& exec, Led& led) -> Coroutine {
+ *     while (true) {
+ *         led.Toggle();
+ *         co_await Timeout(units::milliseconds<float>(500));
+ *     }
+ * }
+ *
+ * CoroutineExecutor<8> executor {};
+ * Blink(executor, led);
+ * @endcode
+ *
+ * A coroutine is spawned onto the executor which is passed as one of its
+ * arguments (or which it is a member of), and starts running the next time the
+ * executor runs. Coroutines are only ever resumed from the executor's task.
+ *
+ * @warning Waiting conditions are evaluated each time the executor runs, so
+ * the period of the executor is the resolution of any waits which are not
+ * accompanied by a notification.
+ */
+namespace obc::scheduling {
+class Executor;
+
+namespace internal {
+/**
+ * @brief A suspended coroutine and the condition it is waiting for.
+ *
+ * Nodes are embedded in awaiters, which live in the coroutine frame for the
+ * duration of the suspension, so no allocation is required.
+ */
+struct Waiter {
+    /// Coroutine to resume once ready.
+    std::coroutine_handle<> handle {};
+    /// Checks if the coroutine can be resumed.
+    bool (*ready)(Waiter& self) {nullptr};
+    /// Next node in the executor's list of waiting coroutines.
+    Waiter* next {nullptr};
+};
+
+/**
+ * @brief Storage for the frames of an executor.
+ *
+ * A base class of the executor placed before \ref Executor, so that it exists
+ * before the free list is built in it.
+ *
+ * @tparam Size Size of the storage in bytes.
+ */
+template<std::size_t Size>
+struct FrameStorage {
+    // Intentionally not value-initialized, it only ever holds the free list
+    // and coroutine frames.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    alignas(std::max_align_t) std::array<std::byte, Size> frames;
+};
+}  // namespace internal
+
+/**
+ * @brief Return type of a fire-and-forget coroutine run by an \ref Executor.
+ *
+ * The frame is destroyed (and returned to the executor's pool) once the
+ * coroutine completes.
+ */
+class Coroutine {
+  public:
+    class promise_type;
+    class Handle;
+
+    /**
+     * @brief Checks if the coroutine was spawned.
+     *
+     * @return False if no frame could be allocated for the coroutine.
+     */
+    explicit operator bool() const { return m_spawned; }
+
+  private:
+    explicit Coroutine(bool spawned) : m_spawned(spawned) {}
+
+    bool m_spawned;
+};
+
+/**
+ * @brief Runs coroutines whose frames are allocated from a fixed pool.
+ *
+ * This is the task independent part of \ref CoroutineExecutor.
+ */
+class Executor {
+  public:
+    Executor(const Executor&)                    = delete;
+    Executor(Executor&&)                         = delete;
+    auto operator=(const Executor&) -> Executor& = delete;
+    auto operator=(Executor&&) -> Executor&      = delete;
+    virtual ~Executor()                          = default;
+
+    /**
+     * @brief Gets the number of frames currently allocated.
+     *
+     * @return Number of live coroutines.
+     */
+    [[nodiscard]] auto FramesInUse() const -> std::size_t {
+        std::scoped_lock lock(m_lock);
+        return m_frames_in_use;
+    }
+
+    /**
+     * @brief Gets the number of coroutines which could not be spawned.
+     *
+     * This happens if the pool is exhausted or a frame is larger than the
+     * frame size of the pool.
+     *
+     * @return Total number of allocation failures.
+     */
+    [[nodiscard]] auto AllocationFailures() const -> std::size_t {
+        std::scoped_lock lock(m_lock);
+        return m_allocation_failures;
+    }
+
+    /**
+     * @brief Registers a suspended coroutine to be resumed once its condition
+     * is met.
+     *
+     * @param waiter Node embedded in the awaiter of the coroutine.
+     */
+    auto Park(internal::Waiter& waiter) -> void {
+        {
+            std::scoped_lock lock(m_lock);
+            waiter.next = m_waiting;
+            m_waiting   = &waiter;
+        }
+        Wake();
+    }
+
+    /**
+     * @brief Requests that the executor runs as soon as possible.
+     *
+     * Should be called whenever an event which a coroutine could be waiting
+     * for occurs.
+     */
+    virtual auto Wake() -> void = 0;
+
+  protected:
+    /**
+     * @brief Creates an executor which allocates frames from a buffer.
+     *
+     * @param frames Storage for frames, which must be aligned to
+     * `std::max_align_t`.
+     * @param frame_size Size of each frame in bytes.
+     */
+    Executor(std::span<std::byte> frames, std::size_t frame_size)
+        : m_frame_size(frame_size) {
+        for (std::size_t offset {0}; offset + frame_size <= frames.size();
+             offset += frame_size)
+            m_free = new (&frames[offset]) FreeFrame {m_free};
+    }
+
+    /**
+     * @brief Resumes every waiting coroutine whose condition has been met.
+     *
+     * A single pass is made over the waiting coroutines. If any were resumed,
+     * the executor wakes itself again so that conditions they satisfied are
+     * rechecked, without starving other tasks.
+     */
+    auto Poll() -> void {
+        internal::Waiter* pending {nullptr};
+        {
+            std::scoped_lock lock(m_lock);
+            pending = std::exchange(m_waiting, nullptr);
+        }
+
+        internal::Waiter* blocked {nullptr};
+        bool              resumed {false};
+        while (pending) {
+            auto* waiter {std::exchange(pending, pending->next)};
+            if (waiter->ready(*waiter)) {
+                // The waiter is destroyed when the coroutine resumes
+                waiter->handle.resume();
+                resumed = true;
+            } else {
+                waiter->next = blocked;
+                blocked      = waiter;
+            }
+        }
+
+        {
+            std::scoped_lock lock(m_lock);
+            while (blocked) {
+                auto* waiter {std::exchange(blocked, blocked->next)};
+                waiter->next = m_waiting;
+                m_waiting    = waiter;
+            }
+        }
+
+        if (resumed) Wake();
+    }
+
+  private:
+    friend class Coroutine::promise_type;
+
+    /**
+     * @brief Free frames are used to store the free list itself.
+     */
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    /// Space reserved before each frame to find its executor again.
+    static constexpr std::size_t kHeaderSize {alignof(std::max_align_t)};
+    static_assert(sizeof(Executor*) <= kHeaderSize);
+
+    auto Allocate(std::size_t size) noexcept -> void* {
+        std::scoped_lock lock(m_lock);
+        if (!m_free || size + kHeaderSize > m_frame_size) {
+            ++m_allocation_failures;
+            return nullptr;
+        }
+
+        // Frames are untyped storage carved out of the pool
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* frame {reinterpret_cast<std::byte*>(
+            std::exchange(m_free, m_free->next)
+        )};
+        *reinterpret_cast<Executor**>(frame) = this;
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        ++m_frames_in_use;
+        return frame + kHeaderSize;
+    }
+
+    static auto Free(void* ptr) noexcept -> void {
+        auto* frame {static_cast<std::byte*>(ptr) - kHeaderSize};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* self {*reinterpret_cast<Executor**>(frame)};
+
+        std::scoped_lock lock(self->m_lock);
+        self->m_free = new (frame) FreeFrame {self->m_free};
+        --self->m_frames_in_use;
+    }
+
+    mutable ipc::SpinLock m_lock {};
+    internal::Waiter*     m_waiting {nullptr};
+    FreeFrame*            m_free {nullptr};
+    std::size_t           m_frame_size;
+    std::size_t           m_frames_in_use {0};
+    std::size_t           m_allocation_failures {0};
+};
+
+/**
+ * @brief Coroutine promise which binds the coroutine to an executor found in
+ * its arguments.
+ *
+ * Coroutines are given a \ref internal::BoundPromise derived from this, which
+ * allocates their frames.
+ */
+class Coroutine::promise_type {
+  public:
+    template<typename... As>
+    explicit promise_type(As&... args) : m_executor(&FindExecutor(args...)) {}
+
+    static auto get_return_object_on_allocation_failure() -> Coroutine {
+        return Coroutine(false);
+    }
+
+    auto get_return_object() -> Coroutine { return Coroutine(true); }
+
+    /**
+     * @brief Suspends the new coroutine until its executor first runs.
+     */
+    auto initial_suspend() -> auto;
+
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+
+    auto return_void() -> void {}
+
+    auto unhandled_exception() -> void { std::terminate(); }
+
+    /**
+     * @brief Gets the executor which runs this coroutine.
+     *
+     * @return The executor.
+     */
+    auto Owner() -> Executor& { return *m_executor; }
+
+  protected:
+    /**
+     * @brief Allocates a frame from the executor among the arguments.
+     *
+     * @return The frame, or nullptr if the executor has none free.
+     */
+    template<typename... As>
+    static auto Allocate(std::size_t size, As&... args) noexcept -> void* {
+        return FindExecutor(args...).Allocate(size);
+    }
+
+    /**
+     * @brief Returns a frame to the executor it was allocated from.
+     */
+    static auto Free(void* ptr) noexcept -> void { Executor::Free(ptr); }
+
+  private:
+    /**
+     * @brief Finds the first argument which is an executor.
+     *
+     * Fails to compile if the coroutine has no executor argument.
+     */
+    template<typename A, typename... As>
+    static auto FindExecutor(A& arg, As&... args) -> Executor& {
+        if constexpr (std::derived_from<std::remove_cvref_t<A>, Executor>)
+            return arg;
+        else
+            return FindExecutor(args...);
+    }
+
+    Executor* m_executor;
+};
+
+namespace internal {
+/**
+ * @brief Promise of a coroutine with particular parameters.
+ *
+ * The allocation functions are not templates, so that compilers can pair
+ * them up (GCC's `-Wmismatched-new-delete` cannot see through a template
+ * `operator new`).
+ *
+ * @tparam As Types of the parameters of the coroutine.
+ */
+template<typename... As>
+class BoundPromise : public Coroutine::promise_type {
+  public:
+    explicit BoundPromise(As&... args) : promise_type(args...) {}
+
+    static auto operator new(std::size_t size, As&... args) noexcept -> void* {
+        return Allocate(size, args...);
+    }
+
+    static auto operator delete(void* ptr) noexcept -> void { Free(ptr); }
+};
+}  // namespace internal
+
+/**
+ * @brief A suspended coroutine run by an executor, whatever its parameters.
+ *
+ * Awaiters take this rather than a typed `std::coroutine_handle`, as each
+ * coroutine has its own promise type.
+ */
+class Coroutine::Handle {
+  public:
+    // Implicit, as the coroutine passes its own typed handle to awaiters
+    template<std::derived_from<promise_type> P>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    Handle(std::coroutine_handle<P> handle)
+        : m_handle(handle), m_owner(&handle.promise().Owner()) {}
+
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    operator std::coroutine_handle<>() const { return m_handle; }
+
+    /**
+     * @brief Gets the executor which runs the coroutine.
+     *
+     * @return The executor.
+     */
+    [[nodiscard]] auto Owner() const -> Executor& { return *m_owner; }
+
+  private:
+    std::coroutine_handle<> m_handle;
+    Executor*               m_owner;
+};
+
+inline auto Coroutine::promise_type::initial_suspend() -> auto {
+    struct Spawn : internal::Waiter {
+        auto await_ready() -> bool { return false; }
+
+        auto await_suspend(Handle h) -> void {
+            handle = h;
+            ready  = [](internal::Waiter& /*self*/) { return true; };
+            h.Owner().Park(*this);
+        }
+
+        auto await_resume() -> void {}
+    };
+
+    return Spawn {};
+}
+}  // namespace obc::scheduling
+
+template<typename... As>
+struct std::coroutine_traits<obc::scheduling::Coroutine, As...> {
+    using promise_type = obc::scheduling::internal::BoundPromise<As...>;
+};
+
+namespace obc::scheduling {
+
+/**
+ * @brief Awaitable which suspends a coroutine until a pollable yields a value.
+ *
+ * The pollable is checked each time the executor runs.
+ *
+ * @tparam F Type of the pollable.
+ */
+template<Pollable F>
+class PollAwaiter : internal::Waiter {
+  public:
+    using Result = decltype(std::declval<F&>()());
+
+    explicit PollAwaiter(F& poll) : m_poll(poll) {
+        ready = [](internal::Waiter& self) {
+            auto& awaiter {static_cast<PollAwaiter&>(self)};
+            return awaiter.Check();
+        };
+    }
+
+    auto await_ready() -> bool { return Check(); }
+
+    auto await_suspend(Coroutine::Handle h) -> void {
+        handle = h;
+        h.Owner().Park(*this);
+    }
+
+    auto await_resume() -> decltype(auto) { return **std::move(m_result); }
+
+  private:
+    auto Check() -> bool {
+        m_result.emplace(m_poll());
+        return static_cast<bool>(*m_result);
+    }
+
+    F&                    m_poll;
+    std::optional<Result> m_result {};
+};
+
+/**
+ * @brief Suspends a coroutine until a timeout elapses.
+ *
+ * @param timeout The timeout to wait for.
+ *
+ * @return An awaitable.
+ */
+inline auto operator co_await(const Timeout& timeout) {
+    struct Elapsed : internal::Waiter {
+        explicit Elapsed(const Timeout& t) : timeout(t) {
+            ready = [](internal::Waiter& self) {
+                return static_cast<bool>(static_cast<Elapsed&>(self).timeout);
+            };
+        }
+
+        auto await_ready() -> bool { return static_cast<bool>(timeout); }
+
+        auto await_suspend(Coroutine::Handle h) -> void {
+            handle = h;
+            h.Owner().Park(*this);
+        }
+
+        auto await_resume() -> void {}
+
+        Timeout timeout;
+    };
+
+    return Elapsed(timeout);
+}
+
+/**
+ * @brief An executor which runs coroutines on a dedicated task.
+ *
+ * @tparam Frames Number of coroutines which can be alive at once.
+ * @tparam FrameSize Maximum size of a coroutine frame in bytes. Frame sizes
+ * are only known once the compiler has laid out the coroutine, so this should
+ * be generous; \ref Executor::AllocationFailures reports if it is not.
+ * @tparam StackDepth Stack depth of the task, shared by all coroutines.
+ */
+template<
+    std::size_t Frames, std::size_t FrameSize = 256,
+    std::uint32_t StackDepth = kDefaultStackDepth>
+class CoroutineExecutor
+    : private internal::FrameStorage<Frames * FrameSize>,
+      public Executor,
+      public StackTask<StackDepth> {
+    static_assert(FrameSize % alignof(std::max_align_t) == 0);
+
+  public:
+    /**
+     * @brief Creates and starts the executor's task.
+     *
+     * @param name Name of the task.
+     * @param resolution Period at which waiting conditions are rechecked.
+     * @param priority Priority of the task.
+     */
+    explicit CoroutineExecutor(
+        const char*      name       = "Coroutines",
+        const Duration   resolution = Duration::Milliseconds(1),
+        const osPriority priority   = osPriorityNormal
+    )
+        // The task is constructed last, as it may start running immediately
+        : Executor(this->frames, FrameSize),
+          StackTask<StackDepth>(name, resolution, priority) {}
+
+    auto Wake() -> void override { this->Notify(); }
+
+  protected:
+    auto Run(WakeReason /*reason*/) -> void override { Poll(); }
+};
+}  // namespace obc::scheduling
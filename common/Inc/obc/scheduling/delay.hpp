@@ -20,12 +20,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <variant>
 
 #include <units/time.h>
 
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/duration.hpp"
 #include "obc/utils/meta.hpp"
 
 #ifdef BALLOON_STM32
@@ -35,6 +40,19 @@
 #endif
 
 namespace obc::scheduling {
+/**
+ * @brief The monotonic system clock used for all timeouts.
+ */
+using Clock = detail::Clock;
+
+/**
+ * @brief A handle used to wake a specific task which is waiting for an event.
+ *
+ * On STM32 this is a direct-to-task notification, which is the cheapest
+ * FreeRTOS primitive for unblocking a task from another task or an ISR.
+ */
+using Notification = detail::Notification;
+
 /**
  * @brief A concept defining an object that can be repeatedly called with no
  * arguments, yielding a specific type.
@@ -52,9 +70,93 @@ concept TypedPollable = requires(T t) {
  */
 template<typename T>
 concept Pollable = requires(T t) {
-    { t() } -> obc::utils::OptionLike<T>;
+    { t() } -> obc::utils::OptionLikeAny;
+};
+
+/**
+ * @brief Fixed-memory accumulator of the cost of polling with a single wait
+ * strategy.
+ *
+ * CPU time is the time spent polling less the time spent sleeping, so time
+ * given to other tasks by a yield is counted against the poller. This is
+ * exact when no other task is ready, which is precisely when busy waiting is
+ * most wasteful.
+ */
+class PollStats {
+  public:
+    /**
+     * @brief A consistent copy of the accumulated statistics.
+     */
+    struct Snapshot {
+        /// Number of completed calls to \ref Timeout::Poll.
+        std::uint32_t              calls {0};
+        /// Number of calls which gave up at their deadline.
+        std::uint32_t              timeouts {0};
+        /// Number of times the polled callable was invoked.
+        std::uint64_t              polls {0};
+        /// CPU time consumed while polling.
+        units::microseconds<float> cpu {0};
+    };
+
+    PollStats() = default;
+
+    /**
+     * @brief Records a completed call to \ref Timeout::Poll.
+     *
+     * @param polls Number of times the callable was invoked.
+     * @param cpu CPU time consumed by the call.
+     * @param timed_out True if the call gave up at its deadline.
+     */
+    auto Record(std::uint32_t polls, Clock::Instant cpu, bool timed_out)
+        -> void;
+
+    /**
+     * @brief Gets a copy of the statistics accumulated so far.
+     *
+     * @return The current statistics.
+     */
+    [[nodiscard]] auto Read() const -> Snapshot;
+
+    /**
+     * @brief Discards all accumulated statistics.
+     */
+    auto Reset() -> void;
+
+  private:
+    mutable ipc::SpinLock m_lock {};
+
+    std::uint32_t  m_calls {0};
+    std::uint32_t  m_timeouts {0};
+    std::uint64_t  m_polls {0};
+    Clock::Instant m_cpu {0};
+};
+
+class Timeout;
+
+/**
+ * @brief A concept defining how \ref Timeout::Poll waits between attempts.
+ *
+ * `Wait` is called after each failed attempt while time remains. Strategies
+ * which sleep set `kSleeps` so that their sleeping time is not counted as CPU
+ * time, and every strategy accumulates its costs in its own \ref PollStats.
+ */
+template<typename W>
+concept WaitStrategy = requires(W w, Timeout& timeout) {
+    { w.Wait(timeout) } -> std::same_as<void>;
+    { W::kSleeps } -> std::convertible_to<bool>;
+    { W::Stats() } -> std::same_as<PollStats&>;
 };
 
+/**
+ * @brief Strategies for waiting between the attempts of a poll.
+ */
+namespace wait {
+class Spin;
+class Yield;
+class Backoff;
+class Notify;
+}  // namespace wait
+
 /**
  * @brief A wrapper for system timeouts, providing high-level functions.
  *
@@ -71,7 +173,20 @@ class Timeout : public detail::Timeout {
      *
      * @param period The duration of the timeout.
      */
-    explicit Timeout(units::microseconds<float> period);
+    explicit Timeout(Duration period) : detail::Timeout(period) {}
+
+    /**
+     * @brief Creates a new timeout which elapses at an absolute point in time.
+     *
+     * Unlike a relative period, this does not accumulate any error from the
+     * time taken to compute the deadline, so it should be preferred when
+     * following a fixed schedule.
+     *
+     * @param deadline The time at which the timeout elapses.
+     *
+     * @return The new timeout.
+     */
+    static auto Until(Clock::Instant deadline) -> Timeout;
 
     class Guard;
 
@@ -81,19 +196,47 @@ class Timeout : public detail::Timeout {
      *
      * If the callable returns a std::nullopt, this indicates that it should be
      * retried if time remains in the timeout. Any other return value is
-     * treated as a success.
+     * treated as a success. The callable is always tried at least once, and
+     * once more after the final wait.
      *
      * @param f The callable object to invoke repeatedly.
+     * @param wait How to wait between attempts, yielding by default.
      *
      * @return The result of the callable or std::nullopt if the timeout
      * expired.
      */
-    template<Pollable F>
-    auto Poll(F& f) -> std::optional<std::remove_reference_t<decltype(*f())>> {
-        while (!(*this)) {
-            if (auto x = f()) return *x;
-            Yield();
+    template<Pollable F, WaitStrategy W = wait::Yield>
+    auto Poll(F&& f, W wait = {})
+        -> std::optional<std::remove_reference_t<decltype(*f())>> {
+        const auto     start {Clock::Now()};
+        Clock::Instant slept {0};
+        std::uint32_t  polls {0};
+
+        const auto record {[&](bool timed_out) {
+            const auto elapsed {Clock::Now() - start};
+            W::Stats().Record(
+                polls, elapsed - std::min(slept, elapsed), timed_out
+            );
+        }};
+
+        for (;;) {
+            ++polls;
+            if (auto x = f()) {
+                record(false);
+                return *x;
+            }
+            if (*this) break;
+
+            if constexpr (W::kSleeps) {
+                const auto before {Clock::Now()};
+                wait.Wait(*this);
+                slept += Clock::Now() - before;
+            } else {
+                wait.Wait(*this);
+            }
         }
+
+        record(true);
         return std::nullopt;
     }
 
@@ -109,15 +252,157 @@ class Timeout : public detail::Timeout {
      *
      * @return True if the callable succeeded before the timeout.
      */
-    template<TypedPollable<bool> F>
-    auto Poll(F& f) -> bool {
-        return Poll<std::monostate>([&] {
-            if (f()) return std::monostate {};
-            return std::nullopt;
-        });
+    template<TypedPollable<bool> F, WaitStrategy W = wait::Yield>
+    auto Poll(F&& f, W wait = {}) -> bool {
+        return Poll(
+                   [&] -> std::optional<std::monostate> {
+                       if (f()) return std::monostate {};
+                       return std::nullopt;
+                   },
+                   std::move(wait)
+        )
+            .has_value();
     }
+
+  private:
+    friend wait::Spin;
+    friend wait::Yield;
+    friend wait::Backoff;
+
+    explicit Timeout(detail::Timeout timeout);
 };
 
+namespace wait {
+/**
+ * @brief Busy waits, retrying immediately.
+ *
+ * Gives the lowest latency, but starves every task of equal or lower priority
+ * for the whole wait. Only suitable for waits of a few microseconds.
+ */
+class Spin {
+  public:
+    static constexpr bool kSleeps = false;
+
+    /**
+     * @brief Returns immediately.
+     *
+     * @param timeout The timeout being polled.
+     */
+    auto Wait(Timeout& timeout) -> void;
+
+    /**
+     * @brief Gets the statistics of all polls which spun.
+     *
+     * @return The statistics.
+     */
+    static auto Stats() -> PollStats&;
+};
+
+/**
+ * @brief Hints to the scheduler that another task may run between attempts.
+ *
+ * This is the historical behaviour of \ref Timeout::Poll. When no task of
+ * equal priority is ready the yield returns immediately, making this no
+ * cheaper than \ref Spin.
+ */
+class Yield {
+  public:
+    static constexpr bool kSleeps = false;
+
+    /**
+     * @brief Yields to other ready tasks.
+     *
+     * @param timeout The timeout being polled.
+     */
+    auto Wait(Timeout& timeout) -> void;
+
+    /**
+     * @brief Gets the statistics of all polls which yielded.
+     *
+     * @return The statistics.
+     */
+    static auto Stats() -> PollStats&;
+};
+
+/**
+ * @brief Sleeps between attempts, doubling the sleep each time.
+ *
+ * Suitable for conditions which have no event to wait on, trading up to one
+ * sleep of latency for giving the CPU back. On STM32 sleeps are rounded to
+ * scheduler ticks, and the final stretch before the deadline is yielded
+ * instead.
+ */
+class Backoff {
+  public:
+    static constexpr bool     kSleeps = true;
+    static constexpr Duration kInitialDelay {Duration::Microseconds(100)};
+    static constexpr Duration kMaxDelay {Duration::Milliseconds(10)};
+
+    /**
+     * @brief Creates a backoff for a single poll.
+     *
+     * @param initial The first sleep.
+     * @param max The longest sleep.
+     */
+    explicit Backoff(
+        Duration initial = kInitialDelay, Duration max = kMaxDelay
+    );
+
+    /**
+     * @brief Sleeps for the current delay and doubles it.
+     *
+     * @param timeout The timeout being polled, sleeps do not extend past it.
+     */
+    auto Wait(Timeout& timeout) -> void;
+
+    /**
+     * @brief Gets the statistics of all polls which backed off.
+     *
+     * @return The statistics.
+     */
+    static auto Stats() -> PollStats&;
+
+  private:
+    Clock::Instant m_delay;
+    Clock::Instant m_max;
+};
+
+/**
+ * @brief Blocks until the calling task is notified.
+ *
+ * The source of the awaited condition (typically an interrupt) must give the
+ * wait notification of the polling task, see \ref Notification::Current.
+ * This uses no CPU time at all while waiting, and leaves the notification
+ * which wakes the task's loop alone.
+ */
+class Notify {
+  public:
+    static constexpr bool kSleeps = true;
+
+    /**
+     * @brief Discards notifications left over from earlier waits.
+     *
+     * The poll checks its condition before it first waits, so nothing given
+     * before this is lost.
+     */
+    Notify();
+
+    /**
+     * @brief Waits for a notification or the deadline.
+     *
+     * @param timeout The timeout being polled.
+     */
+    auto Wait(Timeout& timeout) -> void;
+
+    /**
+     * @brief Gets the statistics of all polls which waited for notifications.
+     *
+     * @return The statistics.
+     */
+    static auto Stats() -> PollStats&;
+};
+}  // namespace wait
+
 /**
  * @brief An RAII wrapper around a delay.
  *
@@ -139,8 +424,8 @@ class Timeout : public detail::Timeout {
  * The delay occurs when the object goes out of scope, allowing for a raw delay
  * to be implemented by creating a guard without storing it.
  *
- * TODO: Log when a timeout "overruns" (the period has already elapsed before
- * the end of the block).
+ * A guard "overruns" when its period has already elapsed by the end of the
+ * block. Overruns of all guards are counted, see \ref Guard::Overruns.
  */
 class Timeout::Guard {
   public:
@@ -159,7 +444,7 @@ class Timeout::Guard {
      *
      * @param period The duration of the delay.
      */
-    explicit Guard(units::microseconds<float> period);
+    explicit Guard(Duration period);
 
     Guard(const Guard&)                    = delete;
     auto operator=(const Guard&) -> Guard& = delete;
@@ -168,9 +453,18 @@ class Timeout::Guard {
 
     /**
      * @brief Blocks for the remaining duration of the timeout.
+     *
+     * In a simulation, returns early if the task is deleted while waiting.
      */
     ~Guard();
 
+    /**
+     * @brief Gets the number of guards which have overrun.
+     *
+     * @return Total number of overruns since startup.
+     */
+    [[nodiscard]] static auto Overruns() -> std::uint32_t;
+
   private:
     Timeout m_timeout;
 };
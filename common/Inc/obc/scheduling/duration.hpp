@@ -0,0 +1,158 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <type_traits>
+
+#include <units/time.h>
+
+namespace obc::scheduling {
+/**
+ * @brief A signed span of time, counted in whole microseconds.
+ *
+ * Scheduling APIs take durations in this form so that timeouts and periods
+ * cost only integer arithmetic, as the FPU is not enabled on either core.
+ * Any `units` time quantity converts implicitly, and the conversion is
+ * constexpr, so a constant such as `units::milliseconds<float>(10)` is
+ * converted when compiling rather than at each call.
+ *
+ * Quantities are rounded to the nearest microsecond, rounding up would turn
+ * the representation error of a float into an extra microsecond.
+ *
+ * Adding a duration to a `Clock::Instant` gives another instant.
+ */
+class Duration {
+  public:
+    /**
+     * @brief Integer type of the microsecond count.
+     */
+    using Rep = std::int64_t;
+
+    constexpr Duration() = default;
+
+    /**
+     * @brief Converts a `units` time quantity.
+     *
+     * @param duration The quantity to convert.
+     */
+    template<typename U>
+        requires std::is_convertible_v<U, units::microseconds<double>>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr Duration(U duration)
+        : m_count(Round(units::microseconds<double>(duration).value())) {}
+
+    /**
+     * @brief Creates a duration from a count of microseconds.
+     *
+     * @param count The number of microseconds.
+     *
+     * @return The duration.
+     */
+    static constexpr auto Microseconds(Rep count) -> Duration {
+        Duration duration {};
+        duration.m_count = count;
+        return duration;
+    }
+
+    /**
+     * @brief Creates a duration from a count of milliseconds.
+     *
+     * @param count The number of milliseconds.
+     *
+     * @return The duration.
+     */
+    static constexpr auto Milliseconds(Rep count) -> Duration {
+        return Microseconds(count * 1'000);
+    }
+
+    /**
+     * @brief Gets the length of the duration.
+     *
+     * @return The number of microseconds.
+     */
+    [[nodiscard]] constexpr auto Count() const -> Rep { return m_count; }
+
+    /**
+     * @brief Gets the length of the duration as an unsigned instant offset,
+     * clamping negative durations to zero.
+     *
+     * @return The number of microseconds, at least zero.
+     */
+    [[nodiscard]] constexpr auto Offset() const -> std::uint64_t {
+        return m_count > 0 ? static_cast<std::uint64_t>(m_count) : 0;
+    }
+
+    /**
+     * @brief Converts back to a `units` quantity, for reporting.
+     *
+     * @return The duration in microseconds.
+     */
+    [[nodiscard]] constexpr auto ToUnits() const -> units::microseconds<float> {
+        return units::microseconds<float>(static_cast<float>(m_count));
+    }
+
+    constexpr auto operator<=>(const Duration&) const = default;
+
+    constexpr auto operator+=(Duration other) -> Duration& {
+        m_count += other.m_count;
+        return *this;
+    }
+
+    constexpr auto operator-=(Duration other) -> Duration& {
+        m_count -= other.m_count;
+        return *this;
+    }
+
+    friend constexpr auto operator+(Duration lhs, Duration rhs) -> Duration {
+        return lhs += rhs;
+    }
+
+    friend constexpr auto operator-(Duration lhs, Duration rhs) -> Duration {
+        return lhs -= rhs;
+    }
+
+    friend constexpr auto operator*(Duration lhs, Rep rhs) -> Duration {
+        return Microseconds(lhs.m_count * rhs);
+    }
+
+    friend constexpr auto operator/(Duration lhs, Rep rhs) -> Duration {
+        return Microseconds(lhs.m_count / rhs);
+    }
+
+    /**
+     * @brief Offsets an instant, negative durations are clamped to zero.
+     */
+    friend constexpr auto operator+(std::uint64_t instant, Duration duration)
+        -> std::uint64_t {
+        return instant + duration.Offset();
+    }
+
+  private:
+    static constexpr auto Round(double count) -> Rep {
+        return count >= 0 ? static_cast<Rep>(count + 0.5)
+                          : -static_cast<Rep>(-count + 0.5);
+    }
+
+    Rep m_count {0};
+};
+}  // namespace obc::scheduling
@@ -0,0 +1,169 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <units/time.h>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+#include "obc/scheduling/task.hpp"
+
+namespace obc::scheduling {
+/**
+ * @brief Schedules a group of periodic tasks earliest-deadline-first.
+ *
+ * FreeRTOS only schedules by fixed priority. The supervisor emulates EDF on
+ * top of it by giving the tasks in its group a band of priorities, ordered so
+ * that the task whose job has the earliest absolute deadline has the highest
+ * priority. Absolute deadlines only change when a job completes, so the group
+ * is re-ranked then, by the completing task, rather than polled each tick.
+ *
+ * Under EDF, any set of tasks with deadlines equal to their periods is
+ * schedulable up to 100% utilisation, where rate-monotonic priorities only
+ * guarantee about 70%.
+ *
+ * @code
+ * EdfSupervisor edf {osPriorityNormal};
+ * edf.Add(telemetry, units::milliseconds<float>(100));
+ * edf.Add(attitude, units::milliseconds<float>(20));
+ * @endcode
+ *
+ * @warning Tasks must remain in the group for as long as they exist, and
+ * should be added before the scheduler starts.
+ */
+class EdfSupervisor {
+  public:
+    /// Most tasks a supervisor can schedule.
+    static constexpr std::size_t kMaxTasks = 16;
+
+    /**
+     * @brief Creates an empty group.
+     *
+     * @param base Lowest priority of the group's band, which extends one
+     * priority per task above it. The band must leave room for
+     * \ref kMaxTasks tasks below the kernel's highest priority.
+     */
+    explicit EdfSupervisor(osPriority base = osPriorityNormal);
+
+    EdfSupervisor(const EdfSupervisor&)                    = delete;
+    EdfSupervisor(EdfSupervisor&&)                         = delete;
+    auto operator=(const EdfSupervisor&) -> EdfSupervisor& = delete;
+    auto operator=(EdfSupervisor&&) -> EdfSupervisor&      = delete;
+    ~EdfSupervisor()                                       = default;
+
+    /**
+     * @brief Adds a task to the group.
+     *
+     * @param task The task, which must not already belong to a group.
+     * @param deadline Time after each release by which the job must complete.
+     *
+     * @return False if the group is full, or its band does not fit below the
+     * kernel's highest priority.
+     */
+    auto Add(Task& task, Duration deadline) -> bool;
+
+    /**
+     * @brief Gets the number of jobs of a task which completed after their
+     * deadline.
+     *
+     * @param task A task in the group.
+     *
+     * @return Deadline misses since the task was added.
+     */
+    [[nodiscard]] auto Misses(const Task& task) const -> std::uint32_t;
+
+    /**
+     * @brief Gets the number of jobs of all tasks which completed after their
+     * deadline.
+     *
+     * @return Deadline misses since the group was created.
+     */
+    [[nodiscard]] auto Misses() const -> std::uint32_t;
+
+    /**
+     * @brief Gets the priority currently given to a task.
+     *
+     * @param task A task in the group.
+     *
+     * @return The priority.
+     */
+    [[nodiscard]] auto Priority(const Task& task) const -> osPriority;
+
+  private:
+    friend class Task;
+
+    struct Entry {
+        Task*          task {nullptr};
+        Clock::Instant relative {0};
+        Clock::Instant absolute {0};
+        std::uint32_t  misses {0};
+        osPriority     priority {osPriorityNone};
+        /// Priority last given to the task, behind \ref priority until
+        /// \ref Apply.
+        osPriority     applied {osPriorityNone};
+    };
+
+    /**
+     * @brief Records a completed job and re-ranks the group.
+     *
+     * @param task Task which completed the job.
+     * @param release Time the job was released.
+     * @param end Time the job completed.
+     * @param next Time of the task's next release.
+     */
+    auto Completed(
+        const Task& task, Clock::Instant release, Clock::Instant end,
+        Clock::Instant next
+    ) -> void;
+
+    /**
+     * @brief Gives the band's priorities out in order of deadline.
+     *
+     * Only records them, the tasks are given them by \ref Apply.
+     */
+    auto Rank() -> void;
+
+    /**
+     * @brief Gives tasks the priorities last ranked.
+     *
+     * Called without \ref m_lock, which masks interrupts on STM32, as
+     * changing a priority may switch tasks.
+     */
+    auto Apply() -> void;
+
+    auto Find(const Task& task) -> Entry*;
+    [[nodiscard]] auto Find(const Task& task) const -> const Entry*;
+
+    osPriority m_base;
+
+    /// Held from ranking until the priorities are applied, so that changes
+    /// are applied in the order they were ranked.
+    ipc::Mutex                   m_rank_lock {};
+    mutable ipc::SpinLock        m_lock {};
+    std::array<Entry, kMaxTasks> m_entries {};
+    std::size_t                  m_size {0};
+    std::uint32_t                m_misses {0};
+};
+}  // namespace obc::scheduling
@@ -0,0 +1,42 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#ifndef BALLOON_HOSTED
+#    error "Simulated time is only available in hosted builds"
+#endif
+
+#include "obc/sys/hosted/sim.hpp"
+
+namespace obc::scheduling {
+/**
+ * @brief Runs tasks, timeouts and notifications against a virtual clock.
+ *
+ * @code
+ * Simulation sim {};
+ * TelemetryTask telemetry {};
+ * sim.RunUntil(6ULL * 60 * 60 * 1'000'000);  // Six hours of flight
+ * @endcode
+ *
+ * @see detail::Simulator
+ */
+using Simulation = detail::Simulator;
+}  // namespace obc::scheduling
@@ -0,0 +1,187 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <units/time.h>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::scheduling {
+/**
+ * @brief Fixed-memory accumulator of timing statistics for a periodic job.
+ *
+ * Each run records its execution time (how long the job itself took) and its
+ * response time (from when it was released until it completed). Response
+ * times are kept in a logarithmic histogram so that the distribution of
+ * latencies can be inspected without storing individual samples.
+ */
+class ExecutionStats {
+  public:
+    /**
+     * @brief Number of buckets in the response time histogram.
+     *
+     * Bucket 0 counts responses under 1us, bucket `i` counts responses in
+     * [2^(i-1), 2^i) us and the final bucket is unbounded.
+     */
+    static constexpr std::size_t kHistogramBuckets = 20;
+
+    /**
+     * @brief A consistent copy of the accumulated statistics.
+     */
+    struct Snapshot {
+        /// Number of completed runs.
+        std::uint32_t                                runs {0};
+        /// Number of runs which completed after their deadline.
+        std::uint32_t                                overruns {0};
+        /// Shortest execution time.
+        units::microseconds<float>                   best {0};
+        /// Longest execution time.
+        units::microseconds<float>                   worst {0};
+        /// Mean execution time.
+        units::microseconds<float>                   mean {0};
+        /// Distribution of response times.
+        std::array<std::uint32_t, kHistogramBuckets> histogram {};
+    };
+
+    ExecutionStats() = default;
+
+    /**
+     * @brief Records a completed run.
+     *
+     * @param execution Time spent executing the job.
+     * @param response Time between the release of the job and its completion.
+     * @param overrun True if the job completed after its deadline.
+     */
+    auto Record(Clock::Instant execution, Clock::Instant response, bool overrun)
+        -> void;
+
+    /**
+     * @brief Gets a copy of the statistics accumulated so far.
+     *
+     * @return The current statistics.
+     */
+    [[nodiscard]] auto Read() const -> Snapshot;
+
+    /**
+     * @brief Discards all accumulated statistics.
+     */
+    auto Reset() -> void;
+
+  private:
+    mutable ipc::SpinLock m_lock {};
+
+    std::uint32_t                                m_runs {0};
+    std::uint32_t                                m_overruns {0};
+    Clock::Instant                               m_best {0};
+    Clock::Instant                               m_worst {0};
+    Clock::Instant                               m_total {0};
+    std::array<std::uint32_t, kHistogramBuckets> m_histogram {};
+};
+
+/**
+ * @brief CPU time consumed by a single task.
+ *
+ * On STM32 this is measured on the microsecond \ref Clock at every context
+ * switch. On the host it is read from the CPU clock of the task's thread.
+ */
+struct CpuUsage {
+    /// CPU time consumed since the task was created.
+    units::microseconds<float> cpu_time {0};
+    /// Number of times the task was switched in.
+    std::uint32_t              context_switches {0};
+};
+
+/**
+ * @brief Cumulative time the CPU has spent running and idle.
+ *
+ * Utilisation over a window is found from the difference of two readings.
+ */
+struct SystemLoad {
+    /// Time elapsed since accounting started.
+    units::microseconds<float> elapsed {0};
+    /// Time spent idle.
+    units::microseconds<float> idle {0};
+
+    /**
+     * @brief Gets the proportion of time spent idle.
+     *
+     * @return Idle time as a percentage of elapsed time.
+     */
+    [[nodiscard]] auto IdlePercent() const -> float {
+        if (elapsed.value() <= 0) return 0;
+        return 100 * idle.value() / elapsed.value();
+    }
+};
+
+/**
+ * @brief Time the CPU has spent asleep in tickless idle.
+ *
+ * On STM32 the idle task stops the scheduler tick and sleeps until the next
+ * task is due, so that an idle system is not woken every millisecond. On the
+ * host this is always empty.
+ */
+struct SleepResidency {
+    /// Number of times the CPU went to sleep.
+    std::uint32_t              sleeps {0};
+    /// Number of sleeps ended by an interrupt before they were due to end.
+    std::uint32_t              early_wakes {0};
+    /// Time spent asleep.
+    units::microseconds<float> asleep {0};
+    /// Worst delay between a sleep ending and the woken task running.
+    units::microseconds<float> wake_latency {0};
+
+    /**
+     * @brief Gets the proportion of time spent asleep.
+     *
+     * @param elapsed Time over which the residency was accumulated.
+     *
+     * @return Time asleep as a percentage of the elapsed time.
+     */
+    [[nodiscard]] auto AsleepPercent(units::microseconds<float> elapsed) const
+        -> float {
+        if (elapsed.value() <= 0) return 0;
+        return 100 * asleep.value() / elapsed.value();
+    }
+};
+
+/**
+ * @brief Peak stack usage of a single task.
+ *
+ * On STM32 this comes from the fill pattern FreeRTOS paints stacks with. On
+ * the host the thread's own stack is painted instead, and as host frames are
+ * larger than target ones the usage is an overestimate.
+ */
+struct StackUsage {
+    /// Name of the task.
+    const char* name {nullptr};
+    /// Size of the stack, in words.
+    std::size_t depth {0};
+    /// Most words of the stack ever used.
+    std::size_t peak {0};
+    /// Stack depth which fits the peak usage with a safety margin.
+    std::size_t recommended {0};
+};
+}  // namespace obc::scheduling
@@ -20,24 +20,64 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <span>
 
 #include <units/time.h>
 
-#include "FreeRTOS.h"
-#include "cmsis_os.h"
+#include "obc/scheduling/analysis.hpp"
 #include "obc/scheduling/delay.hpp"
-#include "task.h"
+#include "obc/scheduling/stats.hpp"
+
+#ifdef BALLOON_STM32
+#    include "obc/sys/stm32/task.hpp"
+#elifdef BALLOON_HOSTED
+#    include "obc/sys/hosted/task.hpp"
+#endif
 
 namespace obc::scheduling {
+/**
+ * @brief Determines how a periodic task recovers after overrunning its period.
+ *
+ * Releases are scheduled on absolute deadlines (each release is exactly one
+ * period after the previous one), so the policy only comes into effect when
+ * `Run` finishes after the next release was due.
+ */
+enum class CatchUpPolicy {
+    /// Drop the missed releases and resume on the original phase.
+    kSkip,
+    /// Run back-to-back until every missed release has been serviced.
+    kBurst,
+    /// Run immediately and restart the period from that point.
+    kRephase,
+};
+
+/**
+ * @brief The reason a task was woken to run.
+ */
+enum class WakeReason {
+    /// The next periodic release was due.
+    kPeriod,
+    /// The task was notified before its next release.
+    kEvent,
+};
+
+class EdfSupervisor;
+
 /**
  * @brief Wrapper around FreeRTOS tasks to adhere to object-oriented
  * conventions.
  *
  * A task object must override certain properties required by FreeRTOS. For
  * simplicity, these properties are immutable and known at compile time.
+ *
+ * On the host, tasks run on threads, or as simulated processes while a
+ * \ref detail::Simulator is active.
  */
 class Task {
   public:
@@ -48,77 +88,406 @@ class Task {
     auto operator=(Task&& other) -> Task&      = delete;
 
     /**
-     * @brief Stops the underlying task immediately.
+     * @brief Stops the underlying task.
+     */
+    virtual ~Task();
+
+    /**
+     * @brief Gets the accumulated offset between the current release schedule
+     * and the one the task started with.
+     *
+     * Only a \ref CatchUpPolicy::kRephase recovery shifts the schedule, the
+     * other policies keep the task phase-locked.
+     *
+     * @return Total phase shift since the task started.
+     */
+    [[nodiscard]] inline auto PhaseError() const -> units::microseconds<float> {
+        return units::microseconds<float>(
+            static_cast<float>(m_phase_error.load(std::memory_order_relaxed))
+        );
+    }
+
+    /**
+     * @brief Gets the number of releases dropped by a \ref CatchUpPolicy::kSkip
+     * recovery.
+     *
+     * @return Total number of skipped releases since the task started.
+     */
+    [[nodiscard]] inline auto MissedReleases() const -> std::uint32_t {
+        return m_missed_releases.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the execution time statistics of the task.
+     *
+     * A run overruns if it completes after the next release was due.
+     *
+     * @return Statistics accumulated since the task started.
+     */
+    [[nodiscard]] inline auto Stats() const -> ExecutionStats::Snapshot {
+        return m_stats.Read();
+    }
+
+    /**
+     * @brief Gets the CPU time consumed by the task.
+     *
+     * Unlike \ref Stats, this includes time spent outside of `Run` and
+     * excludes time during which the task was preempted.
+     *
+     * @return CPU usage since the task was created.
+     */
+    [[nodiscard]] inline auto Usage() const -> CpuUsage {
+        return {
+            .cpu_time = units::microseconds<float>(
+                static_cast<float>(m_control.CpuTime())
+            ),
+            .context_switches = m_control.ContextSwitches(),
+        };
+    }
+
+    /**
+     * @brief Gets the time the CPU has spent running and idle.
+     *
+     * @return Cumulative load since the scheduler started, or since the
+     * program started on the host.
+     */
+    [[nodiscard]] inline static auto Load() -> SystemLoad {
+        return {
+            .elapsed = units::microseconds<float>(
+                static_cast<float>(detail::UpTime())
+            ),
+            .idle = units::microseconds<float>(
+                static_cast<float>(detail::IdleTime())
+            ),
+        };
+    }
+
+    /**
+     * @brief Gets the time the CPU has spent asleep in tickless idle.
+     *
+     * Compare against \ref Load to find how much of the idle time was spent
+     * asleep rather than in the idle task.
+     *
+     * @return Cumulative residency since the scheduler started.
+     */
+    [[nodiscard]] inline static auto Residency() -> SleepResidency {
+        const auto sleep {detail::Residency()};
+        return {
+            .sleeps      = sleep.sleeps,
+            .early_wakes = sleep.early_wakes,
+            .asleep      = units::microseconds<float>(
+                static_cast<float>(sleep.asleep)
+            ),
+            .wake_latency = units::microseconds<float>(
+                static_cast<float>(sleep.wake_latency)
+            ),
+        };
+    }
+
+    /**
+     * @brief Wakes the task to run before its next periodic release.
+     *
+     * Multiple notifications received before the task runs are coalesced into
+     * a single run. The periodic schedule is unaffected, so the period acts as
+     * an upper bound on the time between runs of an event driven task.
+     */
+    inline auto Notify() -> void { m_control.Notifier().Give(); }
+
+    /**
+     * @brief Same as \ref Notify, but safe to call from an interrupt.
+     */
+    inline auto NotifyFromIsr() -> void { m_control.Notifier().GiveFromIsr(); }
+
+    /**
+     * @brief Gets the name the task was created with.
+     *
+     * @return The name.
+     */
+    [[nodiscard]] inline auto Name() const -> const char* { return m_name; }
+
+    /**
+     * @brief Gets the peak stack usage of the task.
+     *
+     * @return Stack usage since the task was created.
+     */
+    [[nodiscard]] auto Stack() const -> StackUsage;
+
+    /**
+     * @brief Gets the stack usage of every existing task.
+     *
+     * Used to find the \ref StackTask depths which fit the tasks' real usage.
+     *
+     * @param usages Filled with the usage of each task, excess tasks are left
+     * out.
+     *
+     * @return Number of existing tasks.
      */
-    virtual inline ~Task() { vTaskDelete(NULL); }
+    static auto StackReport(std::span<StackUsage> usages) -> std::size_t;
 
   protected:
-    // This is interfacing with C-Style FreeRTOS code which uses out
-    // parameters to initialise values
-    // NOLINTBEGIN(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
     /**
      * @brief Creates and starts a new task.
      */
     inline Task(
-        std::span<StackType_t> stack, const char* name = "Unnamed Task",
-        const units::milliseconds<float> nominal_period =
-            units::milliseconds<float>(10),
-        const osPriority priority = osPriorityNormal
+        std::span<detail::StackWord> stack, const char* name = "Unnamed Task",
+        const Duration      nominal_period = Duration::Milliseconds(10),
+        const osPriority    priority = osPriorityNormal,
+        const CatchUpPolicy catch_up = CatchUpPolicy::kSkip
     )
-        : m_handle {xTaskCreateStatic(
-              &RTOSTask, name, stack.size(), this, priority, stack.data(),
-              &m_task_data
-          )},
-          m_nominal_period {nominal_period} {};
+        : m_name {name}, m_stack_depth {stack.size()},
+          // A zero period would never advance the release schedule
+          m_nominal_period {
+              std::max(nominal_period, Duration::Microseconds(1))
+          },
+          m_catch_up {catch_up},
+          m_control(stack, name, priority, &RTOSTask, this) {
+        Register();
+    };
 
-    // NOLINTEND(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    /**
+     * @brief The function to be called periodically (or upon being notified)
+     * to execute the task.
+     *
+     * @param reason Why the task was woken.
+     */
+    virtual auto Run(WakeReason reason) -> void = 0;
 
     /**
-     * @brief The function to be called periodically to execute the task.
+     * @brief Gets an instant before the next periodic release at which the
+     * task must run again.
+     *
+     * Called after each run. Tasks which track their own deadlines can use
+     * this to sleep until exactly when they are needed, rather than polling.
+     * Waking at this instant counts as a \ref WakeReason::kEvent.
+     *
+     * @return The instant, or std::nullopt to wait for the next release.
      */
-    virtual auto Run() -> void = 0;
+    virtual auto NextDeadline() -> std::optional<Clock::Instant> {
+        return std::nullopt;
+    }
 
   private:
+    friend class EdfSupervisor;
+
     /**
      * @brief C-style wrapper function which can be invoked by FreeRTOS.
      *
-     * Repeatedly invokes the periodic run function each NominalPeriod.
+     * Repeatedly invokes the periodic run function each NominalPeriod, or
+     * earlier if the task is notified.
      */
     inline static auto RTOSTask(void* instance) -> void {
         // TODO(evan): Eliminate extra layer of indirection
         auto* task {static_cast<Task*>(instance)};
+        const auto period {task->m_nominal_period.Offset()};
+
+        Clock::Instant release {Clock::Now()};
+        auto           reason {WakeReason::kPeriod};
         while (true) {
-            // TODO(evan): Add compensation so that the average period will
-            // tend towards the nominal_period
-            scheduling::Timeout::Guard timeout {task->m_nominal_period};
-            task->Run();
+            const auto start {Clock::Now()};
+            task->Run(reason);
+            const auto end {Clock::Now()};
+
+            if (reason == WakeReason::kPeriod) {
+                task->m_stats.Record(
+                    end - start, end - release, end > release + period
+                );
+                const auto job {release};
+                task->AdvanceRelease(release, period, end);
+                task->CompleteJob(job, end, release);
+            } else {
+                // The notification time is unknown, so the response time is
+                // approximated by the execution time.
+                task->m_stats.Record(end - start, end - start, false);
+            }
+
+            const auto wake {std::min(
+                release, task->NextDeadline().value_or(release)
+            )};
+            const auto notified {
+                Notification::Take(wake, Notification::Index::kTask)
+            };
+            reason = notified || wake < release ? WakeReason::kEvent
+                                                : WakeReason::kPeriod;
         }
+    }
+
+    /**
+     * @brief Moves on to the release after the one which just completed.
+     *
+     * @param release Time of the completed release, updated to the time of the
+     * next one.
+     * @param period Time between releases.
+     * @param now Time at which the run completed.
+     */
+    inline auto AdvanceRelease(
+        Clock::Instant& release, const Clock::Instant period,
+        const Clock::Instant now
+    ) -> void {
+        release += period;
+        if (now <= release) return;
 
-        vTaskDelete(NULL);
+        const auto lateness {now - release};
+        switch (m_catch_up) {
+            case CatchUpPolicy::kBurst:
+                // The release is already due, run again immediately
+                break;
+            case CatchUpPolicy::kRephase:
+                m_phase_error.fetch_add(
+                    static_cast<std::int64_t>(lateness),
+                    std::memory_order_relaxed
+                );
+                release = now;
+                break;
+            case CatchUpPolicy::kSkip: {
+                // Skip ahead to the first release which is still in the future
+                const auto missed {lateness / period + 1};
+                m_missed_releases.fetch_add(
+                    static_cast<std::uint32_t>(missed),
+                    std::memory_order_relaxed
+                );
+                release += missed * period;
+                break;
+            }
+        }
     }
 
-    TaskHandle_t               m_handle;
-    StaticTask_t               m_task_data;
-    units::milliseconds<float> m_nominal_period;
+    /**
+     * @brief Adds the task to the list of existing tasks.
+     */
+    auto Register() -> void;
+
+    /**
+     * @brief Reports a completed periodic job to the task's EDF group, if any.
+     *
+     * @param release Time the job was released.
+     * @param end Time the job completed.
+     * @param next Time of the next release.
+     */
+    auto CompleteJob(
+        Clock::Instant release, Clock::Instant end, Clock::Instant next
+    ) -> void;
+
+    const char* m_name;
+    std::size_t m_stack_depth;
+    // Next in the list of existing tasks
+    Task*       m_next {nullptr};
+
+    Duration      m_nominal_period;
+    CatchUpPolicy m_catch_up;
+
+    std::atomic<EdfSupervisor*> m_edf {nullptr};
+
+    std::atomic<std::int64_t>  m_phase_error {0};
+    std::atomic<std::uint32_t> m_missed_releases {0};
+    ExecutionStats             m_stats {};
+
+    // Constructed last, as the task may start running immediately
+    detail::TaskControl m_control;
 };
 
+/**
+ * @brief Starts running tasks.
+ *
+ * On STM32 this starts the FreeRTOS scheduler and never returns. On the host,
+ * tasks are released to run on their threads and this returns immediately.
+ */
+inline auto StartScheduler() -> void { detail::StartScheduler(); }
+
 constexpr std::uint32_t kDefaultStackDepth = 4096;
 
+/**
+ * @brief Smallest stack depth recommended for any task, matching
+ * `configMINIMAL_STACK_SIZE`.
+ */
+constexpr std::size_t kMinStackDepth = 128;
+
+/**
+ * @brief Headroom added to the peak stack usage of a task, in percent.
+ */
+constexpr std::size_t kStackMarginPercent = 25;
+
+/**
+ * @brief Gets a stack depth which fits a measured peak usage with a margin.
+ *
+ * Depths are rounded up to a multiple of 8 words, keeping stacks aligned.
+ *
+ * @param peak Peak usage of the stack, in words.
+ * @param margin_percent Headroom to add to the peak.
+ *
+ * @return The recommended depth, in words.
+ */
+constexpr auto RecommendStackDepth(
+    std::size_t peak, std::size_t margin_percent = kStackMarginPercent
+) -> std::size_t {
+    constexpr std::size_t kAlignment {8};
+
+    const auto padded {(peak * (100 + margin_percent) + 99) / 100};
+    const auto aligned {(padded + kAlignment - 1) / kAlignment * kAlignment};
+    return std::max(aligned, kMinStackDepth);
+}
+
+namespace internal {
+/**
+ * @brief Stack of a \ref StackTask, a base so that it exists before the task.
+ */
+template<std::uint32_t StackDepth>
+struct StackStorage {
+    // Intentionally not value-initialized, the task paints it when created,
+    // which zeroing it afterwards would erase.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    std::array<detail::StackWord, StackDepth> task_stack;
+};
+}  // namespace internal
+
 /**
  * @brief Mixin class to statically create a fixed-size stack for a task.
  */
 template<std::uint32_t StackDepth = kDefaultStackDepth>
-class StackTask : public Task {
+class StackTask : private internal::StackStorage<StackDepth>, public Task {
   protected:
     StackTask(
-        const char*                      name = "Unnamed Task",
-        const units::milliseconds<float> nominal_period =
-            units::milliseconds<float>(10),
-        const osPriority priority = osPriorityNormal
+        const char*         name = "Unnamed Task",
+        const Duration      nominal_period = Duration::Milliseconds(10),
+        const osPriority    priority = osPriorityNormal,
+        const CatchUpPolicy catch_up = CatchUpPolicy::kSkip
     )
-        : Task(m_task_stack, name, nominal_period, priority) = default;
+        : Task(this->task_stack, name, nominal_period, priority, catch_up) {}
+};
 
-  private:
-    std::array<StackType_t, StackDepth> m_task_stack {};
+/**
+ * @brief A task whose period, priority and stack come from a \ref TaskSet.
+ *
+ * Priorities are assigned rate-monotonically, with the lowest priority task
+ * in the set running at `osPriorityNormal`.
+ *
+ * @tparam Set The task set which has been checked for schedulability.
+ * @tparam I Index of this task in the set.
+ */
+template<typename Set, std::size_t I>
+class ScheduledTask : public StackTask<Set::kTasks.at(I).stack_depth> {
+    static_assert(I < Set::kSize);
+    static_assert(
+        Set::kSize <= osPriorityRealtime - osPriorityNormal,
+        "Task set has more tasks than available priorities"
+    );
+
+  public:
+    /// Priority assigned to this task.
+    static constexpr auto kPriority {static_cast<osPriority>(
+        osPriorityNormal + (Set::kSize - 1 - Set::kAnalysis.ranks.at(I))
+    )};
+
+  protected:
+    explicit ScheduledTask(
+        const char*         name     = "Unnamed Task",
+        const CatchUpPolicy catch_up = CatchUpPolicy::kSkip
+    )
+        : StackTask<Set::kTasks.at(I).stack_depth>(
+              name,
+              Duration::Microseconds(
+                  static_cast<Duration::Rep>(Set::kTasks.at(I).period)
+              ),
+              kPriority, catch_up
+          ) {}
 };
 }  // namespace obc::scheduling
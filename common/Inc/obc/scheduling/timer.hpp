@@ -0,0 +1,207 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "obc/ipc/callback.hpp"
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/delay.hpp"
+
+namespace obc::scheduling {
+class TimerWheel;
+
+/**
+ * @brief Handle to a timer started on a \ref TimerWheel.
+ *
+ * Like \ref utils::Handle, the timer is a node in an intrusive list whose
+ * storage belongs to whoever started it. The timer is cancelled when the handle
+ * is destroyed, so a handle which is not stored cancels its timer immediately.
+ */
+class Timer {
+  public:
+    /**
+     * @brief Creates a handle which does not refer to any timer.
+     */
+    Timer() = default;
+
+    Timer(const Timer& other)                    = delete;
+    auto operator=(const Timer& other) -> Timer& = delete;
+
+    /**
+     * @brief Moves the timer to a new location, updating adjacent nodes.
+     */
+    Timer(Timer&& other) noexcept;
+
+    /**
+     * @brief Cancels this timer and moves another into its place.
+     */
+    auto operator=(Timer&& other) noexcept -> Timer&;
+
+    /**
+     * @brief Cancels the timer.
+     */
+    ~Timer();
+
+    /**
+     * @brief Stops the timer from firing again.
+     *
+     * @warning The callback may still be running on the timer service task
+     * when this returns.
+     */
+    auto Cancel() -> void;
+
+    /**
+     * @brief Checks if the timer will fire again.
+     *
+     * @return False once a one-shot timer has fired or any timer is cancelled.
+     */
+    [[nodiscard]] auto Active() const -> bool;
+
+  private:
+    friend class TimerWheel;
+
+    Timer(
+        TimerWheel& wheel, ipc::Callback<void> callback, std::uint64_t expiry,
+        std::uint64_t period
+    );
+
+    /**
+     * @brief Takes over the position of another timer in its wheel.
+     *
+     * This timer must not be linked into a wheel.
+     */
+    auto MoveFrom(Timer& other) -> void;
+
+    TimerWheel*   m_wheel {nullptr};
+    Timer*        m_prev {nullptr};
+    Timer*        m_next {nullptr};
+    /// Head of the slot the timer is linked into, or null if not linked.
+    Timer**       m_slot {nullptr};
+    std::uint8_t  m_level {0};
+    std::uint8_t  m_index {0};
+    /// Tick at which the timer is due.
+    std::uint64_t m_expiry {0};
+    /// Ticks between firings, or 0 for a one-shot timer.
+    std::uint64_t m_period {0};
+
+    std::optional<ipc::Callback<void>> m_callback {};
+};
+
+/**
+ * @brief Hierarchical timing wheel which schedules callbacks.
+ *
+ * Time is divided into ticks. Each level of the wheel has 64 slots which each
+ * cover one revolution of the level below, so timers due soon are kept at
+ * tick resolution while distant ones are held in coarse slots and cascaded
+ * down as they approach. Starting and cancelling a timer are O(1), and
+ * advancing only touches occupied slots and level boundaries.
+ *
+ * Timers further away than the span of the wheel (2^24 ticks) are parked in
+ * the top level and re-inserted each time it completes a revolution.
+ *
+ * The wheel does not keep time itself, it is driven by \ref Advance, normally
+ * from a \ref TimerService.
+ */
+class TimerWheel {
+  public:
+    /// Number of slots in each level.
+    static constexpr std::size_t kSlots = 64;
+    /// Number of levels.
+    static constexpr std::size_t kLevels = 4;
+
+    /**
+     * @brief Creates an empty wheel.
+     *
+     * @param tick Resolution of the wheel in microseconds.
+     * @param origin Instant corresponding to the first tick.
+     */
+    explicit TimerWheel(Clock::Instant tick, Clock::Instant origin = 0);
+
+    TimerWheel(const TimerWheel& other)                    = delete;
+    TimerWheel(TimerWheel&& other)                         = delete;
+    auto operator=(const TimerWheel& other) -> TimerWheel& = delete;
+    auto operator=(TimerWheel&& other) -> TimerWheel&      = delete;
+    ~TimerWheel()                                          = default;
+
+    /**
+     * @brief Starts a timer.
+     *
+     * The expiry is rounded up to the next tick, so a timer never fires early.
+     *
+     * @param callback Callback invoked each time the timer fires.
+     * @param expiry Instant at which the timer first fires.
+     * @param period Time between subsequent firings, or 0 for a one-shot timer.
+     *
+     * @return Handle which must be retained for the timer to remain active.
+     */
+    [[nodiscard]] auto Start(
+        ipc::Callback<void> callback, Clock::Instant expiry,
+        Clock::Instant period = 0
+    ) -> Timer;
+
+    /**
+     * @brief Fires every timer which is due.
+     *
+     * Callbacks are invoked without the wheel locked, so they may start or
+     * cancel timers. A periodic timer which has fallen more than a period
+     * behind skips the firings it missed.
+     *
+     * @param now Current time.
+     *
+     * @return Number of callbacks invoked.
+     */
+    auto Advance(Clock::Instant now) -> std::size_t;
+
+    /**
+     * @brief Gets the next instant at which \ref Advance has work to do.
+     *
+     * This is exact for timers due within the lowest level, otherwise it is
+     * the time at which the next occupied coarse slot must be cascaded.
+     *
+     * @return The instant, or std::nullopt if no timers are active.
+     */
+    [[nodiscard]] auto NextExpiry() const -> std::optional<Clock::Instant>;
+
+  private:
+    friend class Timer;
+
+    auto Insert(Timer& timer) -> void;
+    auto Unlink(Timer& timer) -> void;
+    auto Cascade() -> void;
+    /// Removes the next due timer, re-arming it if it is periodic.
+    auto PopExpired(std::uint64_t now) -> std::optional<ipc::Callback<void>>;
+
+    mutable ipc::SpinLock m_lock {};
+
+    Clock::Instant m_tick;
+    Clock::Instant m_origin;
+    /// Every tick before this one has been processed.
+    std::uint64_t  m_current {0};
+
+    std::array<std::array<Timer*, kSlots>, kLevels> m_slots {};
+    /// Bitmap of non-empty slots in each level.
+    std::array<std::uint64_t, kLevels>              m_occupied {};
+};
+}  // namespace obc::scheduling
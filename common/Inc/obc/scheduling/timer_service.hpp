@@ -0,0 +1,118 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <units/time.h>
+
+#include "obc/ipc/callback.hpp"
+#include "obc/scheduling/delay.hpp"
+#include "obc/scheduling/task.hpp"
+#include "obc/scheduling/timer.hpp"
+
+namespace obc::scheduling {
+namespace internal {
+/**
+ * @brief Timers of a \ref TimerService, a base so that they exist before its
+ * task starts.
+ */
+struct WheelStorage {
+    WheelStorage(Clock::Instant tick, Clock::Instant origin)
+        : wheel(tick, origin) {}
+
+    TimerWheel wheel;
+};
+}  // namespace internal
+
+/**
+ * @brief Task which fires callbacks after a delay or periodically.
+ *
+ * Timers are kept in a \ref TimerWheel, and the task sleeps until the next one
+ * is due, so pending timers (such as request timeouts, retransmissions and
+ * watchdog deadlines) cost no CPU time while idle.
+ *
+ * @code
+ * TimerService<> timers {};
+ * auto retransmit {timers.Start(
+ *     OBC_CALLBACK_METHOD(*this, Retransmit), units::milliseconds<float>(50)
+ * )};
+ * @endcode
+ *
+ * Callbacks run on the service's task and should be short, as they delay
+ * every other timer.
+ *
+ * @tparam StackDepth Stack depth of the task, which callbacks run on.
+ */
+template<std::uint32_t StackDepth = kDefaultStackDepth>
+class TimerService : private internal::WheelStorage,
+                     public StackTask<StackDepth> {
+  public:
+    /**
+     * @brief Creates and starts the service's task.
+     *
+     * @param name Name of the task.
+     * @param resolution Tick of the timer wheel.
+     * @param priority Priority of the task.
+     */
+    explicit TimerService(
+        const char*      name       = "Timers",
+        const Duration   resolution = Duration::Milliseconds(1),
+        const osPriority priority   = osPriorityHigh
+    )
+        // The task is constructed last, as it may start running immediately.
+        // Its period only bounds how long it sleeps without timers.
+        : WheelStorage(resolution.Offset(), Clock::Now()),
+          StackTask<StackDepth>(name, units::seconds<float>(1), priority) {}
+
+    /**
+     * @brief Starts a timer.
+     *
+     * @param callback Callback invoked each time the timer fires.
+     * @param delay Time until the timer first fires.
+     * @param period Time between subsequent firings, or 0 for a one-shot
+     * timer.
+     *
+     * @return Handle which must be retained for the timer to remain active.
+     */
+    [[nodiscard]] auto Start(
+        ipc::Callback<void> callback, const Duration delay,
+        const Duration period = {}
+    ) -> Timer {
+        auto timer {
+            wheel.Start(callback, Clock::Now() + delay, period.Offset())
+        };
+        // The new timer may be due before the task would otherwise wake
+        this->Notify();
+        return timer;
+    }
+
+  protected:
+    auto Run(WakeReason /*reason*/) -> void override {
+        wheel.Advance(Clock::Now());
+    }
+
+    auto NextDeadline() -> std::optional<Clock::Instant> override {
+        return wheel.NextExpiry();
+    }
+};
+}  // namespace obc::scheduling
@@ -20,11 +20,51 @@
 
 #pragma once
 
-#include <units/time.h>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "obc/scheduling/duration.hpp"
 
 namespace obc::scheduling::detail {
+struct SimProcess;
+
+/**
+ * @brief Thrown inside a task's thread to unwind it when the task is deleted.
+ *
+ * Thrown by \ref Notification::Take, which a task's loop reaches after every
+ * run. While simulating, every other wait of the task throws it too, so the
+ * task never returns into an object which is being destroyed.
+ */
+struct TaskStopped {};
+
+/**
+ * @brief Monotonic microsecond clock backed by `std::chrono::steady_clock`.
+ *
+ * While a \ref Simulator is active, this is the simulator's virtual clock
+ * instead.
+ */
+class Clock {
+  public:
+    /**
+     * @brief A point in time, in microseconds since an arbitrary epoch.
+     */
+    using Instant = std::uint64_t;
+
+    /**
+     * @brief Gets the current time.
+     *
+     * @return Microseconds elapsed since the epoch.
+     */
+    static auto Now() -> Instant;
+};
+
 /**
- * @brief A wrapper for TODO timeouts.
+ * @brief A timeout on the host's monotonic clock.
+ *
+ * While a \ref Simulator is active, waiting and yielding hand control to the
+ * other simulated tasks instead.
  */
 class Timeout {
   public:
@@ -35,25 +75,39 @@ class Timeout {
      *
      * @param period The duration of the timeout.
      */
-    explicit Timeout(units::microseconds<float> period);
+    explicit Timeout(Duration period);
+
+    /**
+     * @brief Creates a timeout which elapses at an absolute point in time.
+     *
+     * @param deadline The time at which the timeout elapses.
+     *
+     * @return The new timeout.
+     */
+    static auto Until(Clock::Instant deadline) -> Timeout;
 
     /**
      * @brief Checks if the timeout period has elapsed.
      *
      * @return True if the timeout has elapsed.
      */
-    explicit(false) operator bool();
+    explicit(false) operator bool() const;
 
     /**
      * @brief Waits for the remaining duration of the timeout.
      *
-     * @warning Currently, this is implemented as a pure busy loop.
-     *
-     * TODO: Switch to a hybrid approach: busy loop for short periods and yield
-     * to the system scheduler for longer periods.
+     * The thread sleeps until shortly before the deadline and busy waits for
+     * the remainder, hiding the wake-up latency of the host scheduler.
      */
     auto Block() -> void;
 
+    /**
+     * @brief Gets the time at which the timeout elapses.
+     *
+     * @return The deadline.
+     */
+    [[nodiscard]] auto Deadline() const -> Clock::Instant;
+
   protected:
     /**
      * @brief Hint to the scheduler that it should probably context switch to
@@ -66,5 +120,135 @@ class Timeout {
      * performed after the final yield.
      */
     auto Yield() -> void;
+
+    /**
+     * @brief Called on each iteration of a busy wait.
+     *
+     * A no-op, except while simulating where virtual time only advances when
+     * control is handed to the simulator.
+     */
+    auto Spin() -> void;
+
+    /**
+     * @brief Sleeps without busy waiting until a point in time, or the
+     * deadline of the timeout if that is sooner.
+     *
+     * @param until The time to sleep until.
+     */
+    auto Sleep(Clock::Instant until) -> void;
+
+  private:
+    explicit Timeout(Clock::Instant deadline);
+
+    Clock::Instant m_deadline;
+};
+
+/**
+ * @brief A handle to a per-thread notification, emulating FreeRTOS
+ * direct-to-task notifications.
+ *
+ * Notifications are counted but coalesced; a waiting thread consumes all
+ * pending notifications at once.
+ *
+ * @warning A handle must not outlive the thread it refers to.
+ */
+class Notification {
+  public:
+    /**
+     * @brief Notifications of a thread, mirroring the FreeRTOS notification
+     * array of a task.
+     *
+     * Blocking waits take their own notification, so that they neither
+     * consume nor leave behind the ones which wake the task's loop.
+     */
+    enum class Index : std::uint8_t {
+        /// Wakes the task's loop early, see Task::Notify.
+        kTask = 0,
+        /// Wakes a blocking wait of the thread, see \ref Current.
+        kWait = 1,
+    };
+
+    /**
+     * @brief Gets a handle to the wait notification of the calling thread.
+     *
+     * This is the notification to hand out to whoever ends a blocking wait,
+     * such as \ref wait::Notify.
+     *
+     * @return The handle.
+     */
+    static auto Current() -> Notification;
+
+    /**
+     * @brief Wakes the thread if it is waiting, otherwise the notification is
+     * left pending.
+     */
+    auto Give() -> void;
+
+    /**
+     * @brief Same as \ref Give, there are no interrupts on the host.
+     */
+    auto GiveFromIsr() -> void;
+
+    /**
+     * @brief Same as \ref Give, there are no interrupts on the host.
+     */
+    auto GiveFromAny() -> void;
+
+    /**
+     * @brief Waits for the calling thread to be notified.
+     *
+     * @param deadline The time at which to give up waiting.
+     * @param index    Which of the thread's notifications to wait for.
+     *
+     * @return True if a notification was consumed, false if the deadline
+     * passed first.
+     *
+     * @throws TaskStopped if the calling task is deleted while waiting.
+     */
+    static auto Take(Clock::Instant deadline, Index index) -> bool;
+
+    /**
+     * @brief Discards the pending notifications of the calling thread.
+     *
+     * @param index Which of the thread's notifications to clear.
+     */
+    static auto Clear(Index index) -> void;
+
+    /**
+     * @brief State of a notification, which belongs to a single thread.
+     */
+    struct Slot {
+        std::mutex              lock {};
+        std::condition_variable cv {};
+        std::uint32_t           pending {0};
+        /// Simulated process waiting on the notification, if any.
+        SimProcess*             waiter {nullptr};
+        /// Set to unwind the owning thread when its task is deleted.
+        bool                    stopping {false};
+    };
+
+    /// State of all notifications of a thread, by \ref Index.
+    using Slots = std::array<Slot, 2>;
+
+    /**
+     * @brief Creates a handle to a notification.
+     *
+     * @param slot State of the notification.
+     */
+    explicit Notification(Slot& slot);
+
+    /**
+     * @brief Makes slots the notifications of the calling thread.
+     *
+     * Used by tasks, whose notifications must exist before their thread.
+     *
+     * @param slots State of the notifications, which must outlive the thread.
+     */
+    static auto Bind(Slots& slots) -> void;
+
+  private:
+    static auto CurrentSlot(Index index) -> Slot&;
+
+    Slot* m_slot;
 };
 }  // namespace obc::scheduling::detail
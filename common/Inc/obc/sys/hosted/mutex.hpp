@@ -22,7 +22,65 @@
 
 #include <mutex>
 
+#include "obc/ipc/profile.hpp"
+
 namespace obc::ipc {
+#ifdef BALLOON_LOCK_PROFILING
+/**
+ * @brief Standard library mutex which records itself in the \ref LockProfile.
+ *
+ * Kinds which mask interrupts on the STM32 count their time waiting and held
+ * as masked.
+ *
+ * @tparam K Kind of lock being stood in for.
+ */
+template <LockKind K>
+class ProfiledMutex {
+  public:
+    /**
+     * @brief Locks the mutex, blocking if necessary.
+     */
+    [[gnu::noinline]] auto lock() -> void {
+        const auto* site {__builtin_return_address(0)};
+        if constexpr (K != LockKind::kMutex) detail::MaskBegin(site, K);
+        const auto start {m_probe.Start()};
+        const bool contended {!m_mutex.try_lock()};
+        if (contended) m_mutex.lock();
+        m_probe.Acquired(site, start, contended);
+    }
+
+    /**
+     * @brief Unlocks the mutex.
+     */
+    auto unlock() -> void {
+        m_probe.Released(K);
+        m_mutex.unlock();
+        if constexpr (K != LockKind::kMutex) detail::MaskEnd();
+    }
+
+    /**
+     * @brief Attempts to lock the mutex without blocking.
+     *
+     * @return True if the lock was acquired successfully, false otherwise.
+     */
+    [[gnu::noinline]] auto try_lock() -> bool {
+        const auto start {m_probe.Start()};
+        if (!m_mutex.try_lock()) return false;
+        const auto* site {__builtin_return_address(0)};
+        if constexpr (K != LockKind::kMutex) detail::MaskBegin(site, K);
+        m_probe.Acquired(site, start, false);
+        return true;
+    }
+
+  private:
+    std::mutex        m_mutex {};
+    detail::LockProbe m_probe {};
+};
+
+using Mutex    = ProfiledMutex<LockKind::kMutex>;
+using SpinLock = ProfiledMutex<LockKind::kSpinLock>;
+using IsrLock  = ProfiledMutex<LockKind::kIsrLock>;
+#else
 /**
  * @brief Use the standard library mutex if available.
  */
@@ -32,4 +90,10 @@ using Mutex = std::mutex;
  * @brief Use the standard library mutex if available.
  */
 using SpinLock = std::mutex;
+
+/**
+ * @brief There are no interrupts on the host.
+ */
+using IsrLock = std::mutex;
+#endif
 }  // namespace obc::ipc
@@ -0,0 +1,248 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "obc/sys/hosted/delay.hpp"
+
+namespace obc::scheduling::detail {
+/**
+ * @brief A thread whose execution is controlled by a \ref Simulator.
+ */
+struct SimProcess;
+
+/**
+ * @brief Discrete-event scheduler which runs tasks against a virtual clock.
+ *
+ * While a simulator exists, \ref Clock reports virtual time, and timeouts,
+ * task periods and notifications wait in virtual time. Each task still runs
+ * on its own thread, but only one thread (a task, or the driver which created
+ * the simulator) runs at any moment. Control passes between them whenever the
+ * running one waits, so time only advances when every task is idle.
+ *
+ * Code runs in zero virtual time, tasks are never preempted, and events due at
+ * the same instant are run in priority order (then in the order they were
+ * scheduled). Consequently a simulation is reproducible run to run, and hours
+ * of mostly idle flight time take seconds to simulate.
+ *
+ * The driver advances the simulation with \ref RunUntil, or by waiting on a
+ * timeout as a task would.
+ *
+ * @warning Only one simulator may exist at a time, and tasks must not be
+ * created while a simulation is running on another thread.
+ */
+class Simulator {
+  public:
+    /**
+     * @brief Starts simulating, with virtual time starting at 0.
+     */
+    Simulator();
+
+    Simulator(const Simulator& other)                    = delete;
+    Simulator(Simulator&& other)                         = delete;
+    auto operator=(const Simulator& other) -> Simulator& = delete;
+    auto operator=(Simulator&& other) -> Simulator&      = delete;
+
+    /**
+     * @brief Stops every process and returns to real time.
+     */
+    ~Simulator();
+
+    /**
+     * @brief Gets the simulator which is currently active.
+     *
+     * @return The simulator, or nullptr if time is not simulated.
+     */
+    static auto Active() -> Simulator*;
+
+    /**
+     * @brief Gets the current virtual time.
+     *
+     * @return Microseconds since the simulation started.
+     */
+    [[nodiscard]] auto Now() const -> Clock::Instant;
+
+    /**
+     * @brief Gets the number of times control has been passed to a process.
+     *
+     * @return Total number of events processed.
+     */
+    [[nodiscard]] auto Events() const -> std::uint64_t;
+
+    /**
+     * @brief Runs every event up to and including a point in time.
+     *
+     * Must be called by the driver, not from a process.
+     *
+     * @param end The virtual time to stop at.
+     */
+    auto RunUntil(Clock::Instant end) -> void;
+
+    /**
+     * @brief Starts a new process at the current time.
+     *
+     * @param body Function run by the process.
+     * @param priority Processes with a higher value run first when they are
+     * due at the same time.
+     *
+     * @return The process.
+     */
+    auto Spawn(std::function<void()> body, int priority)
+        -> std::shared_ptr<SimProcess>;
+
+    /**
+     * @brief Stops a process.
+     *
+     * The process is resumed and unwound by \ref TaskStopped, which every
+     * wait it makes from then on throws. Must be called by the driver.
+     *
+     * @param process The process to stop.
+     */
+    auto Stop(SimProcess& process) -> void;
+
+    /**
+     * @brief Changes the priority of a process.
+     *
+     * A wake-up which is already scheduled is moved to the new priority, so
+     * that it is ordered as if the priority had always applied.
+     *
+     * @param process The process.
+     * @param priority The new priority.
+     */
+    auto SetPriority(SimProcess& process, int priority) -> void;
+
+    /**
+     * @brief Waits until a point in time.
+     *
+     * From the driver, this runs the simulation up to that time.
+     *
+     * @param deadline The time to resume at.
+     */
+    auto SleepUntil(Clock::Instant deadline) -> void;
+
+    /**
+     * @brief Lets every other process due at the current time run, and
+     * otherwise skips ahead to the next event (or the deadline).
+     *
+     * Used by polling loops, which would otherwise never let time advance.
+     *
+     * @param deadline The time by which to resume at the latest.
+     */
+    auto YieldUntil(Clock::Instant deadline) -> void;
+
+    /**
+     * @brief Waits until woken by \ref Wake, or a point in time.
+     *
+     * @param deadline The time at which to give up waiting.
+     *
+     * @return True if woken before the deadline.
+     */
+    auto Block(Clock::Instant deadline) -> bool;
+
+    /**
+     * @brief Resumes a process waiting in \ref Block at the current time.
+     *
+     * @param process The process to wake.
+     */
+    auto Wake(SimProcess& process) -> void;
+
+    /**
+     * @brief Checks if the process running on the calling thread is being
+     * stopped.
+     *
+     * @return True if the process should return as soon as it can.
+     */
+    static auto Stopping() -> bool;
+
+    /**
+     * @brief Gets the process running on the calling thread.
+     *
+     * @return The process, or nullptr if called by the driver.
+     */
+    static auto Current() -> SimProcess*;
+
+  private:
+    struct Event {
+        Clock::Instant time;
+        int            priority;
+        std::uint64_t  sequence;
+        SimProcess*    process;
+        std::uint64_t  generation;
+
+        /// Orders the queue so the earliest, highest priority event is first.
+        auto operator<(const Event& other) const -> bool;
+    };
+
+    /// Queues a process to run, superseding any event already queued for it.
+    auto Schedule(SimProcess& process, Clock::Instant time, int priority)
+        -> void;
+    /// Pops the next process due before the end of the run, if any.
+    auto NextDue() -> SimProcess*;
+    /// Passes control to a process, or to the driver if null.
+    auto Hand(SimProcess* next) -> void;
+    /// Passes control on and waits to be resumed, throws TaskStopped once the
+    /// process is stopping.
+    auto Park(SimProcess& process, std::unique_lock<std::mutex>& lock)
+        -> void;
+    /// Entry point of each process thread.
+    auto ProcessMain(SimProcess& process, const std::function<void()>& body)
+        -> void;
+
+    std::mutex                  m_lock {};
+    std::condition_variable     m_driver {};
+    /// Process which currently has control, or nullptr for the driver.
+    SimProcess*                 m_running {nullptr};
+    std::atomic<Clock::Instant> m_now {0};
+    /// Time at which the current run ends.
+    Clock::Instant              m_end {0};
+    std::uint64_t               m_sequence {0};
+    std::atomic<std::uint64_t>  m_events {0};
+
+    std::priority_queue<Event>               m_queue {};
+    std::vector<std::shared_ptr<SimProcess>> m_processes {};
+};
+
+struct SimProcess {
+    std::condition_variable resume {};
+    std::thread             thread {};
+    int                     priority {0};
+    /// Incremented whenever the process is rescheduled, invalidating older
+    /// events.
+    std::uint64_t           generation {0};
+    /// Time and priority of the latest event, while it is pending.
+    Clock::Instant          due {0};
+    int                     due_priority {0};
+    bool                    pending {false};
+    bool                    blocked {false};
+    bool                    woken {false};
+    bool                    stopping {false};
+    bool                    finished {false};
+};
+}  // namespace obc::scheduling::detail
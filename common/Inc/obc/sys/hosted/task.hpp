@@ -0,0 +1,211 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include <sys/types.h>
+
+#include "obc/sys/hosted/delay.hpp"
+
+// NOLINTBEGIN(readability-identifier-naming)
+/**
+ * @brief Stand-in for the CMSIS-RTOS priorities, so that tasks are declared
+ * identically on the host.
+ */
+enum osPriority : std::int32_t {
+    osPriorityNone        = 0,
+    osPriorityIdle        = 1,
+    osPriorityLow         = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal      = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh        = 40,
+    osPriorityRealtime    = 48,
+    osPriorityISR         = 56,
+    osPriorityError       = -1,
+};
+// NOLINTEND(readability-identifier-naming)
+
+namespace obc::scheduling::detail {
+/**
+ * @brief Word type of task stacks, which are unused on the host.
+ */
+using StackWord = std::uint32_t;
+
+/**
+ * @brief Number of task priorities, as configured on target.
+ */
+constexpr std::uint32_t kPriorities {osPriorityISR};
+
+/**
+ * @brief Lets tasks start running.
+ *
+ * As with FreeRTOS, tasks created before the scheduler starts wait for it, so
+ * that they are fully constructed before they first run.
+ */
+auto StartScheduler() -> void;
+
+/**
+ * @brief Gets the wall time elapsed since the program started.
+ *
+ * Unlike \ref Clock, this is never virtual, as CPU time is always real.
+ *
+ * @return Elapsed time in microseconds.
+ */
+auto UpTime() -> Clock::Instant;
+
+/**
+ * @brief Gets the wall time during which the program was not using the CPU.
+ *
+ * Measured against a single core, so it is zero whenever the program keeps
+ * at least one core busy.
+ *
+ * @return Idle time in microseconds.
+ */
+auto IdleTime() -> Clock::Instant;
+
+/**
+ * @brief Time spent asleep in tickless idle.
+ */
+struct SleepStats {
+    /// Number of times the core went to sleep.
+    std::uint32_t  sleeps {0};
+    /// Number of sleeps ended by an interrupt before the next tick was due.
+    std::uint32_t  early_wakes {0};
+    /// Time spent asleep, in microseconds.
+    Clock::Instant asleep {0};
+    /// Worst delay between a sleep ending and a task running, in microseconds.
+    Clock::Instant wake_latency {0};
+};
+
+/**
+ * @brief Gets the time spent asleep in tickless idle.
+ *
+ * Threads already sleep in the host kernel without a tick, so there is
+ * nothing to measure.
+ *
+ * @return Empty statistics.
+ */
+inline auto Residency() -> SleepStats { return {}; }
+
+/**
+ * @brief A task backed by a thread.
+ *
+ * While a \ref Simulator is active, the thread is run as a simulated process
+ * instead, with its priority deciding the order of simultaneous events.
+ * Simulated tasks start when the simulation is first run, rather than when
+ * the scheduler starts.
+ */
+class TaskControl {
+  public:
+    /**
+     * @brief Creates and starts a task.
+     *
+     * @param stack Unused, threads allocate their own stacks, though its size
+     * sets how much of the thread's stack is profiled.
+     * @param name Unused.
+     * @param priority Priority of the task.
+     * @param entry Function run by the task.
+     * @param arg Argument passed to the function.
+     */
+    TaskControl(
+        std::span<StackWord> stack, const char* name, osPriority priority,
+        void (*entry)(void*), void* arg
+    );
+
+    TaskControl(const TaskControl& other)                    = delete;
+    TaskControl(TaskControl&& other)                         = delete;
+    auto operator=(const TaskControl& other) -> TaskControl& = delete;
+    auto operator=(TaskControl&& other) -> TaskControl&      = delete;
+
+    /**
+     * @brief Stops the task the next time it waits for a notification, and
+     * waits for its thread to exit.
+     */
+    ~TaskControl();
+
+    /**
+     * @brief Gets a handle to the notification which wakes the task's loop.
+     *
+     * @return The handle.
+     */
+    [[nodiscard]] auto Notifier() -> Notification {
+        return Notification(
+            m_slots[std::to_underlying(Notification::Index::kTask)]
+        );
+    }
+
+    /**
+     * @brief Gets the CPU time consumed by the task's thread.
+     *
+     * @return CPU time in microseconds, or zero if the thread has not started.
+     */
+    [[nodiscard]] auto CpuTime() const -> Clock::Instant;
+
+    /**
+     * @brief Gets the number of times the task's thread was switched in by the
+     * host.
+     *
+     * @return The number of context switches, or zero if the host does not
+     * report them.
+     */
+    [[nodiscard]] auto ContextSwitches() const -> std::uint32_t;
+
+    /**
+     * @brief Gets the most words of the task's stack ever used.
+     *
+     * On starting, the thread paints part of its stack below its entry point
+     * (at least twice the task's nominal stack), this finds how much of the
+     * paint has since been overwritten.
+     *
+     * @return The peak stack usage, in words, or zero if the thread has not
+     * started.
+     */
+    [[nodiscard]] auto StackPeak() const -> std::size_t;
+
+    /**
+     * @brief Changes the priority of the task.
+     *
+     * Only simulated tasks have priorities, host threads are all equal.
+     *
+     * @param priority The new priority.
+     */
+    auto SetPriority(osPriority priority) -> void;
+
+  private:
+    // Identify the thread once it is running
+    std::atomic<clockid_t>      m_cpu_clock {};
+    std::atomic<pid_t>          m_tid {0};
+    std::size_t                 m_paint_size;
+    std::atomic<std::byte*>     m_paint {nullptr};
+    Notification::Slots         m_slots {};
+    std::shared_ptr<SimProcess> m_process {};
+    std::thread                 m_thread {};
+};
+}  // namespace obc::scheduling::detail
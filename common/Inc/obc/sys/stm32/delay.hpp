@@ -20,12 +20,44 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <FreeRTOS.h>
-#include <units/time.h>
+#include <task.h>
+
+#include "obc/scheduling/duration.hpp"
 
 namespace obc::scheduling::detail {
 /**
- * @brief A wrapper for FreeRTOS timeouts.
+ * @brief Monotonic microsecond clock backed by a free-running hardware timer.
+ *
+ * TIM5 (a 32-bit timer shared by both cores) is prescaled to tick at 1MHz and
+ * extended to 64 bits in software. The timer is started by the first core to
+ * read the clock, so both cores observe the same time base.
+ *
+ * @warning The software extension relies on the clock being read at least
+ * once per wrap of the hardware counter (~71 minutes). Any periodic task or
+ * timeout satisfies this.
+ */
+class Clock {
+  public:
+    /**
+     * @brief A point in time, in microseconds since the timer started.
+     */
+    using Instant = std::uint64_t;
+
+    /**
+     * @brief Gets the current time.
+     *
+     * Safe to call from interrupts.
+     *
+     * @return Microseconds elapsed since the timer was started.
+     */
+    static auto Now() -> Instant;
+};
+
+/**
+ * @brief A microsecond resolution timeout driven by \ref Clock.
  */
 class Timeout {
   public:
@@ -36,25 +68,40 @@ class Timeout {
      *
      * @param period The duration of the timeout.
      */
-    explicit Timeout(units::microseconds<float> period);
+    explicit Timeout(Duration period);
+
+    /**
+     * @brief Creates a timeout which elapses at an absolute point in time.
+     *
+     * @param deadline The time at which the timeout elapses.
+     *
+     * @return The new timeout.
+     */
+    static auto Until(Clock::Instant deadline) -> Timeout;
 
     /**
      * @brief Checks if the timeout period has elapsed.
      *
      * @return True if the timeout has elapsed.
      */
-    operator bool();
+    operator bool() const;
 
     /**
      * @brief Waits for the remaining duration of the timeout.
      *
-     * @warning Currently, this is implemented as a pure busy loop.
-     *
-     * TODO: Switch to a hybrid approach: busy loop for short periods and yield
-     * to the system scheduler for longer periods.
+     * Whole scheduler ticks which are certain to elapse before the deadline
+     * are slept through, the final (sub-tick) stretch is spent busy waiting on
+     * the clock.
      */
     auto Block() -> void;
 
+    /**
+     * @brief Gets the time at which the timeout elapses.
+     *
+     * @return The deadline.
+     */
+    [[nodiscard]] auto Deadline() const -> Clock::Instant;
+
   protected:
     /**
      * @brief Hint to the scheduler that it should probably context switch to
@@ -68,8 +115,111 @@ class Timeout {
      */
     auto Yield() -> void;
 
+    /**
+     * @brief Called on each iteration of a busy wait.
+     *
+     * A no-op, the clock is read by the caller.
+     */
+    auto Spin() -> void;
+
+    /**
+     * @brief Sleeps without busy waiting until roughly a point in time.
+     *
+     * Sleeps are rounded up to whole scheduler ticks, but never run past the
+     * deadline of the timeout. When less than a tick remains before the
+     * deadline, this yields instead.
+     *
+     * @param until The time to sleep until.
+     */
+    auto Sleep(Clock::Instant until) -> void;
+
+  private:
+    explicit Timeout(Clock::Instant deadline);
+
+    Clock::Instant m_deadline;
+};
+
+/**
+ * @brief A handle to a direct-to-task notification of a FreeRTOS task.
+ *
+ * Notifications are counted but coalesced; a waiting task consumes all
+ * pending notifications at once.
+ */
+class Notification {
+  public:
+    /**
+     * @brief Notifications of a task, one per index of its FreeRTOS
+     * notification array.
+     *
+     * Blocking waits take their own notification, so that they neither
+     * consume nor leave behind the ones which wake the task's loop.
+     */
+    enum class Index : UBaseType_t {
+        /// Wakes the task's loop early, see Task::Notify.
+        kTask = 0,
+        /// Wakes a blocking wait of the task, see \ref Current.
+        kWait = 1,
+    };
+
+    /**
+     * @brief Creates a handle to a notification of a task.
+     *
+     * @param task  The task to be notified.
+     * @param index Which of the task's notifications to give.
+     */
+    Notification(TaskHandle_t task, Index index);
+
+    /**
+     * @brief Gets a handle to the wait notification of the calling task.
+     *
+     * This is the notification to hand out to whoever ends a blocking wait,
+     * such as \ref wait::Notify.
+     *
+     * @return The handle.
+     */
+    static auto Current() -> Notification;
+
+    /**
+     * @brief Wakes the task if it is waiting, otherwise the notification is
+     * left pending.
+     */
+    auto Give() -> void;
+
+    /**
+     * @brief Same as \ref Give, but safe to call from an interrupt.
+     */
+    auto GiveFromIsr() -> void;
+
+    /**
+     * @brief Same as \ref Give, but picks \ref GiveFromIsr when called from
+     * an interrupt.
+     *
+     * For code such as callbacks which may run in either context.
+     */
+    auto GiveFromAny() -> void;
+
+    /**
+     * @brief Waits for the calling task to be notified.
+     *
+     * Uses the same hybrid approach as \ref Timeout::Block.
+     *
+     * @param deadline The time at which to give up waiting.
+     * @param index    Which of the task's notifications to wait for.
+     *
+     * @return True if a notification was consumed, false if the deadline
+     * passed first.
+     */
+    static auto Take(Clock::Instant deadline, Index index) -> bool;
+
+    /**
+     * @brief Discards the pending notifications of the calling task.
+     *
+     * @param index Which of the task's notifications to clear.
+     */
+    static auto Clear(Index index) -> void;
+
   private:
-    TimeOut_t  m_timeout;
-    TickType_t m_period;
+    TaskHandle_t m_task;
+    Index        m_index;
 };
 }  // namespace obc::scheduling::detail
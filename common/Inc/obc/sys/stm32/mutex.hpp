@@ -24,6 +24,9 @@
 
 #include <FreeRTOS.h>
 #include <semphr.h>
+#include <task.h>
+
+#include "obc/ipc/profile.hpp"
 
 namespace obc::ipc {
 /**
@@ -54,8 +57,9 @@ class Mutex {
     auto try_lock() -> bool;
 
   private:
-    SemaphoreHandle_t m_handle;
-    StaticSemaphore_t m_data;
+    SemaphoreHandle_t                       m_handle;
+    StaticSemaphore_t                       m_data;
+    [[no_unique_address]] detail::LockProbe m_probe {};
 };
 
 /**
@@ -79,6 +83,9 @@ class CriticalGuard {
      * @brief Leaves the critical section by re-enabling interrupts.
      */
     ~CriticalGuard();
+
+  private:
+    [[no_unique_address]] detail::LockProbe m_probe {};
 };
 
 /**
@@ -113,6 +120,34 @@ class SpinLock {
     auto try_lock() -> bool;
 
   private:
-    std::atomic_flag m_lock {false};
+    std::atomic_flag                        m_lock {false};
+    [[no_unique_address]] detail::LockProbe m_probe {};
+};
+
+/**
+ * @brief Lock which may be taken from both tasks and interrupts.
+ *
+ * Masks every interrupt which may call FreeRTOS, so guarded sections must be
+ * only a few instructions long. Interrupts above
+ * `configMAX_SYSCALL_INTERRUPT_PRIORITY` must not use it.
+ *
+ * @warning Not safe against the other core, only against preemption.
+ */
+class IsrLock {
+  public:
+    /**
+     * @brief Masks interrupts.
+     */
+    auto lock() -> void;
+
+    /**
+     * @brief Restores the interrupt mask from before \ref lock.
+     */
+    auto unlock() -> void;
+
+  private:
+    // Only accessed while interrupts are masked
+    UBaseType_t                             m_saved {0};
+    [[no_unique_address]] detail::LockProbe m_probe {};
 };
 }  // namespace obc::ipc
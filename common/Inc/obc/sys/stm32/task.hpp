@@ -0,0 +1,205 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "FreeRTOS.h"
+#include "cmsis_os.h"
+#include "obc/sys/stm32/delay.hpp"
+#include "task.h"
+
+namespace obc::scheduling::detail {
+/**
+ * @brief Word type of task stacks.
+ */
+using StackWord = StackType_t;
+
+/**
+ * @brief Starts the FreeRTOS scheduler and CPU accounting, never returns.
+ */
+[[noreturn]] auto StartScheduler() -> void;
+
+/**
+ * @brief Gets the time elapsed since the scheduler started.
+ *
+ * @return Elapsed time in microseconds.
+ */
+auto UpTime() -> Clock::Instant;
+
+/**
+ * @brief Gets the time the idle task has run since the scheduler started.
+ *
+ * @return Idle time in microseconds.
+ */
+auto IdleTime() -> Clock::Instant;
+
+/**
+ * @brief Time spent asleep in tickless idle.
+ *
+ * Updated by the `configPRE_SLEEP_PROCESSING` and
+ * `configPOST_SLEEP_PROCESSING` hooks in `FreeRTOSConfig.h`.
+ */
+struct SleepStats {
+    /// Number of times the core went to sleep.
+    std::uint32_t  sleeps {0};
+    /// Number of sleeps ended by an interrupt before the next tick was due.
+    std::uint32_t  early_wakes {0};
+    /// Time spent asleep, in microseconds.
+    Clock::Instant asleep {0};
+    /// Worst delay between a sleep ending and a task running, in microseconds.
+    Clock::Instant wake_latency {0};
+};
+
+/**
+ * @brief Gets the time spent asleep in tickless idle.
+ *
+ * @return Cumulative statistics since the scheduler started.
+ */
+auto Residency() -> SleepStats;
+
+/**
+ * @brief Gets the recent worst latency of waking from tickless idle.
+ *
+ * Sleeps which wait on \ref Clock wake this much earlier, so that the time
+ * taken to restart the tick and switch to the woken task does not make them
+ * late. The estimate rises to any worse latency at once, and decays towards
+ * the latency of later wakes, so a single outlier does not last forever.
+ *
+ * @return Latency in microseconds, at most one tick.
+ */
+auto WakeLatency() -> Clock::Instant;
+
+/**
+ * @brief CPU accounting of a task, updated by the context switch hooks.
+ *
+ * The hooks are installed by `traceTASK_SWITCHED_OUT` and
+ * `traceTASK_SWITCHED_IN` in `FreeRTOSConfig.h`, and find the accounting of
+ * a task through its first thread local storage pointer.
+ */
+struct RunTime {
+    /// CPU time consumed, excluding the current slice.
+    Clock::Instant cpu {0};
+    /// Number of times the task was switched in.
+    std::uint32_t  switches {0};
+};
+
+/**
+ * @brief Number of task priorities, tasks run at priorities below this.
+ */
+constexpr std::uint32_t kPriorities {configMAX_PRIORITIES};
+
+/**
+ * @brief Index of the thread local storage pointer holding \ref RunTime.
+ */
+constexpr BaseType_t kRunTimeSlot {0};
+
+/**
+ * @brief A statically allocated FreeRTOS task.
+ */
+class TaskControl {
+  public:
+    // This is interfacing with C-Style FreeRTOS code which uses out
+    // parameters to initialise values
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    /**
+     * @brief Creates and starts a task.
+     *
+     * @param stack Stack of the task.
+     * @param name Name of the task.
+     * @param priority Priority of the task.
+     * @param entry Function run by the task, which must never return.
+     * @param arg Argument passed to the function.
+     */
+    TaskControl(
+        std::span<StackWord> stack, const char* name, osPriority priority,
+        void (*entry)(void*), void* arg
+    )
+        : m_depth {stack.size()},
+          m_handle {xTaskCreateStatic(
+              entry, name, stack.size(), arg, priority, stack.data(),
+              &m_task_data
+          )} {
+        // A task which preempts its creator runs unaccounted until this
+        vTaskSetThreadLocalStoragePointer(m_handle, kRunTimeSlot, &m_run_time);
+    }
+
+    // NOLINTEND(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+
+    TaskControl(const TaskControl& other)                    = delete;
+    TaskControl(TaskControl&& other)                         = delete;
+    auto operator=(const TaskControl& other) -> TaskControl& = delete;
+    auto operator=(TaskControl&& other) -> TaskControl&      = delete;
+
+    /**
+     * @brief Deletes the task.
+     */
+    ~TaskControl() { vTaskDelete(m_handle); }
+
+    /**
+     * @brief Gets a handle to the notification which wakes the task's loop.
+     *
+     * @return The handle.
+     */
+    [[nodiscard]] auto Notifier() const -> Notification {
+        return {m_handle, Notification::Index::kTask};
+    }
+
+    /**
+     * @brief Gets the CPU time consumed by the task.
+     *
+     * @return CPU time in microseconds.
+     */
+    [[nodiscard]] auto CpuTime() const -> Clock::Instant;
+
+    /**
+     * @brief Gets the number of times the task was switched in.
+     *
+     * @return The number of context switches.
+     */
+    [[nodiscard]] auto ContextSwitches() const -> std::uint32_t;
+
+    /**
+     * @brief Gets the most words of the task's stack ever used.
+     *
+     * Found from the fill pattern FreeRTOS paints stacks with on creation.
+     *
+     * @return The peak stack usage, in words.
+     */
+    [[nodiscard]] auto StackPeak() const -> std::size_t;
+
+    /**
+     * @brief Changes the priority of the task.
+     *
+     * @param priority The new priority.
+     */
+    auto SetPriority(osPriority priority) -> void;
+
+  private:
+    // Must exist before the task, which may start running immediately
+    RunTime      m_run_time {};
+    std::size_t  m_depth;
+    TaskHandle_t m_handle;
+    StaticTask_t m_task_data;
+};
+}  // namespace obc::scheduling::detail
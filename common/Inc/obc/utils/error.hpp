@@ -21,9 +21,12 @@
 #pragma once
 
 #include <concepts>
+#include <cstdlib>
 #include <expected>
 
-#include <stm32h7xx_hal_def.h>
+#ifdef BALLOON_STM32
+#    include <stm32h7xx_hal_def.h>
+#endif
 
 #include "obc/utils/meta.hpp"
 
@@ -99,6 +102,11 @@ concept PredicateFunction = requires(T& f, const U& x) {
 
 // NOLINTEND(cppcoreguidelines-macro-usage)
 
+[[noreturn]] inline auto Panic() -> void {
+    // TODO(evan): make this do something more useful than stopping
+    std::abort();
+}
+
 template<OptionLikeAny T>
 inline auto UnwrapOrPanic(T x) -> std::remove_reference_t<decltype(*x)> {
     if (static_cast<bool>(x)) return *x;
@@ -111,11 +119,9 @@ inline auto CheckOrPanic(T x, C& check) -> T {
     Panic();
 }
 
-inline auto [[noreturn]] Panic() -> void {
-    // TODO(evan): make this do something
-}
-
+#ifdef BALLOON_STM32
 inline auto IsHalOk(const HAL_StatusTypeDef status) -> bool {
     return status == HAL_OK;
 }
+#endif
 }  // namespace obc::utils
@@ -20,14 +20,108 @@
 
 #include "obc/scheduling/delay.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include <units/frequency.h>
 
 namespace obc::scheduling {
-Timeout::Timeout(units::microseconds<float> period) : detail::Timeout(period) {}
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint32_t> g_guard_overruns {0};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+PollStats g_spin_stats {};
+PollStats g_yield_stats {};
+PollStats g_backoff_stats {};
+PollStats g_notify_stats {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto ToInstant(Duration period) -> Clock::Instant {
+    return std::max<Clock::Instant>(period.Offset(), 1);
+}
+}  // namespace
+
+auto PollStats::Record(std::uint32_t polls, Clock::Instant cpu, bool timed_out)
+    -> void {
+    std::scoped_lock lock(m_lock);
+    ++m_calls;
+    if (timed_out) ++m_timeouts;
+    m_polls += polls;
+    m_cpu += cpu;
+}
+
+auto PollStats::Read() const -> Snapshot {
+    std::scoped_lock lock(m_lock);
+    return {
+        .calls    = m_calls,
+        .timeouts = m_timeouts,
+        .polls    = m_polls,
+        .cpu      = units::microseconds<float>(static_cast<float>(m_cpu)),
+    };
+}
+
+auto PollStats::Reset() -> void {
+    std::scoped_lock lock(m_lock);
+    m_calls    = 0;
+    m_timeouts = 0;
+    m_polls    = 0;
+    m_cpu      = 0;
+}
+
+Timeout::Timeout(detail::Timeout timeout) : detail::Timeout(timeout) {}
+
+auto Timeout::Until(Clock::Instant deadline) -> Timeout {
+    return Timeout(detail::Timeout::Until(deadline));
+}
 
 Timeout::Guard::Guard(Timeout timeout) : m_timeout(timeout) {}
 
-Timeout::Guard::Guard(units::microseconds<float> period) : m_timeout(period) {}
+Timeout::Guard::Guard(Duration period) : m_timeout(period) {}
+
+Timeout::Guard::~Guard() {
+    if (m_timeout) g_guard_overruns.fetch_add(1, std::memory_order_relaxed);
+#ifdef BALLOON_HOSTED
+    // A simulated task being deleted ends the wait early, the exception cannot
+    // leave a destructor
+    try {
+        m_timeout.Block();
+    } catch (const detail::TaskStopped&) {}
+#else
+    m_timeout.Block();
+#endif
+}
+
+auto Timeout::Guard::Overruns() -> std::uint32_t {
+    return g_guard_overruns.load(std::memory_order_relaxed);
+}
+
+namespace wait {
+auto Spin::Wait(Timeout& timeout) -> void { timeout.Spin(); }
+
+auto Spin::Stats() -> PollStats& { return g_spin_stats; }
+
+auto Yield::Wait(Timeout& timeout) -> void { timeout.Yield(); }
+
+auto Yield::Stats() -> PollStats& { return g_yield_stats; }
+
+Backoff::Backoff(Duration initial, Duration max)
+    : m_delay(ToInstant(initial)), m_max(std::max(ToInstant(max), m_delay)) {}
+
+auto Backoff::Wait(Timeout& timeout) -> void {
+    timeout.Sleep(Clock::Now() + m_delay);
+    m_delay = std::min(m_delay * 2, m_max);
+}
+
+auto Backoff::Stats() -> PollStats& { return g_backoff_stats; }
+
+Notify::Notify() { Notification::Clear(Notification::Index::kWait); }
+
+auto Notify::Wait(Timeout& timeout) -> void {
+    Notification::Take(timeout.Deadline(), Notification::Index::kWait);
+}
 
-Timeout::Guard::~Guard() { m_timeout.Block(); }
+auto Notify::Stats() -> PollStats& { return g_notify_stats; }
+}  // namespace wait
 }  // namespace obc::scheduling
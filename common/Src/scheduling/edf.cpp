@@ -0,0 +1,133 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/scheduling/edf.hpp"
+
+#include <mutex>
+
+namespace obc::scheduling {
+EdfSupervisor::EdfSupervisor(osPriority base) : m_base(base) {}
+
+auto EdfSupervisor::Add(Task& task, Duration deadline) -> bool {
+    if (m_base + kMaxTasks - 1 >= detail::kPriorities) return false;
+
+    const auto relative {deadline.Offset()};
+
+    std::scoped_lock rank_lock(m_rank_lock);
+    {
+        std::scoped_lock lock(m_lock);
+        if (m_size == kMaxTasks) return false;
+
+        m_entries.at(m_size++) = {
+            .task     = &task,
+            .relative = relative,
+            // The task's release schedule is unknown until its first job ends
+            .absolute = Clock::Now() + relative,
+        };
+        task.m_edf.store(this, std::memory_order_release);
+        Rank();
+    }
+
+    Apply();
+    return true;
+}
+
+auto EdfSupervisor::Misses(const Task& task) const -> std::uint32_t {
+    std::scoped_lock lock(m_lock);
+    const auto*      entry {Find(task)};
+    return entry ? entry->misses : 0;
+}
+
+auto EdfSupervisor::Misses() const -> std::uint32_t {
+    std::scoped_lock lock(m_lock);
+    return m_misses;
+}
+
+auto EdfSupervisor::Priority(const Task& task) const -> osPriority {
+    std::scoped_lock lock(m_lock);
+    const auto*      entry {Find(task)};
+    return entry ? entry->priority : osPriorityNone;
+}
+
+auto EdfSupervisor::Completed(
+    const Task& task, Clock::Instant release, Clock::Instant end,
+    Clock::Instant next
+) -> void {
+    std::scoped_lock rank_lock(m_rank_lock);
+    {
+        std::scoped_lock lock(m_lock);
+        auto*            entry {Find(task)};
+        if (!entry) return;
+
+        if (end > release + entry->relative) {
+            ++entry->misses;
+            ++m_misses;
+        }
+        entry->absolute = next + entry->relative;
+        Rank();
+    }
+
+    Apply();
+}
+
+auto EdfSupervisor::Rank() -> void {
+    // Insertion sort, the group is small and usually already nearly sorted
+    std::array<Entry*, kMaxTasks> order {};
+    for (std::size_t i {0}; i < m_size; ++i) {
+        auto* entry {&m_entries.at(i)};
+        auto  j {i};
+        for (; j > 0 && order.at(j - 1)->absolute > entry->absolute; --j)
+            order.at(j) = order.at(j - 1);
+        order.at(j) = entry;
+    }
+
+    for (std::size_t rank {0}; rank < m_size; ++rank) {
+        auto*      entry {order.at(rank)};
+        const auto priority {
+            static_cast<osPriority>(m_base + (m_size - 1 - rank))
+        };
+        entry->priority = priority;
+    }
+}
+
+auto EdfSupervisor::Apply() -> void {
+    // Entries and their priorities only change under m_rank_lock, which the
+    // caller holds
+    for (std::size_t i {0}; i < m_size; ++i) {
+        auto& entry {m_entries.at(i)};
+        if (entry.applied == entry.priority) continue;
+
+        entry.applied = entry.priority;
+        entry.task->m_control.SetPriority(entry.applied);
+    }
+}
+
+auto EdfSupervisor::Find(const Task& task) -> Entry* {
+    for (std::size_t i {0}; i < m_size; ++i)
+        if (m_entries.at(i).task == &task) return &m_entries.at(i);
+    return nullptr;
+}
+
+auto EdfSupervisor::Find(const Task& task) const -> const Entry* {
+    for (std::size_t i {0}; i < m_size; ++i)
+        if (m_entries.at(i).task == &task) return &m_entries.at(i);
+    return nullptr;
+}
+}  // namespace obc::scheduling
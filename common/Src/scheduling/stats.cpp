@@ -0,0 +1,68 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/scheduling/stats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+
+namespace obc::scheduling {
+auto ExecutionStats::Record(
+    Clock::Instant execution, Clock::Instant response, bool overrun
+) -> void {
+    const auto bucket {std::min<std::size_t>(
+        std::bit_width(response), kHistogramBuckets - 1
+    )};
+
+    std::scoped_lock lock(m_lock);
+    m_best  = m_runs ? std::min(m_best, execution) : execution;
+    m_worst = std::max(m_worst, execution);
+    m_total += execution;
+    ++m_runs;
+    if (overrun) ++m_overruns;
+    ++m_histogram.at(bucket);
+}
+
+auto ExecutionStats::Read() const -> Snapshot {
+    std::scoped_lock lock(m_lock);
+    return {
+        .runs      = m_runs,
+        .overruns  = m_overruns,
+        .best      = units::microseconds<float>(static_cast<float>(m_best)),
+        .worst     = units::microseconds<float>(static_cast<float>(m_worst)),
+        .mean      = units::microseconds<float>(
+            m_runs ? static_cast<float>(m_total) / static_cast<float>(m_runs)
+                        : 0.0F
+        ),
+        .histogram = m_histogram,
+    };
+}
+
+auto ExecutionStats::Reset() -> void {
+    std::scoped_lock lock(m_lock);
+    m_runs      = 0;
+    m_overruns  = 0;
+    m_best      = 0;
+    m_worst     = 0;
+    m_total     = 0;
+    m_histogram = {};
+}
+}  // namespace obc::scheduling
@@ -0,0 +1,93 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/scheduling/task.hpp"
+
+#include <mutex>
+
+#include "obc/ipc/mutex.hpp"
+#include "obc/scheduling/edf.hpp"
+
+namespace obc::scheduling {
+namespace {
+/**
+ * @brief List of existing tasks.
+ *
+ * Function-local, as tasks are commonly constructed during static
+ * initialisation.
+ */
+struct Registry {
+    ipc::Mutex lock {};
+    Task*      head {nullptr};
+};
+
+auto GetRegistry() -> Registry& {
+    static Registry registry {};
+    return registry;
+}
+}  // namespace
+
+Task::~Task() {
+    auto& registry {GetRegistry()};
+    std::scoped_lock lock(registry.lock);
+    for (auto** link {&registry.head}; *link; link = &(*link)->m_next) {
+        if (*link == this) {
+            *link = m_next;
+            break;
+        }
+    }
+}
+
+auto Task::Register() -> void {
+    auto& registry {GetRegistry()};
+    std::scoped_lock lock(registry.lock);
+    // Appended, so that reports list tasks in the order they were created
+    auto** link {&registry.head};
+    while (*link) link = &(*link)->m_next;
+    *link = this;
+}
+
+auto Task::CompleteJob(
+    Clock::Instant release, Clock::Instant end, Clock::Instant next
+) -> void {
+    if (auto* edf {m_edf.load(std::memory_order_acquire)})
+        edf->Completed(*this, release, end, next);
+}
+
+auto Task::Stack() const -> StackUsage {
+    const auto peak {m_control.StackPeak()};
+    return {
+        .name        = m_name,
+        .depth       = m_stack_depth,
+        .peak        = peak,
+        .recommended = RecommendStackDepth(peak),
+    };
+}
+
+auto Task::StackReport(std::span<StackUsage> usages) -> std::size_t {
+    auto& registry {GetRegistry()};
+    std::scoped_lock lock(registry.lock);
+
+    std::size_t count {0};
+    for (const auto* task {registry.head}; task; task = task->m_next, ++count)
+        if (count < usages.size()) usages[count] = task->Stack();
+    return count;
+}
+}  // namespace obc::scheduling
@@ -0,0 +1,264 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/scheduling/timer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <utility>
+
+namespace obc::scheduling {
+namespace {
+/// Number of tick bits covered by each level of the wheel.
+constexpr std::size_t   kBits {6};
+constexpr std::uint64_t kMask {TimerWheel::kSlots - 1};
+
+static_assert(TimerWheel::kSlots == 1U << kBits);
+}  // namespace
+
+Timer::Timer(
+    TimerWheel& wheel, ipc::Callback<void> callback, std::uint64_t expiry,
+    std::uint64_t period
+)
+    : m_wheel(&wheel), m_expiry(expiry), m_period(period),
+      m_callback(callback) {}
+
+Timer::Timer(Timer&& other) noexcept { MoveFrom(other); }
+
+auto Timer::operator=(Timer&& other) noexcept -> Timer& {
+    if (this == &other) return *this;
+
+    Cancel();
+    MoveFrom(other);
+    return *this;
+}
+
+Timer::~Timer() { Cancel(); }
+
+auto Timer::Cancel() -> void {
+    if (!m_wheel) return;
+
+    std::scoped_lock lock(m_wheel->m_lock);
+    if (m_slot) m_wheel->Unlink(*this);
+}
+
+auto Timer::Active() const -> bool {
+    if (!m_wheel) return false;
+
+    std::scoped_lock lock(m_wheel->m_lock);
+    return m_slot != nullptr;
+}
+
+auto Timer::MoveFrom(Timer& other) -> void {
+    m_wheel = std::exchange(other.m_wheel, nullptr);
+    if (!m_wheel) return;
+
+    std::scoped_lock lock(m_wheel->m_lock);
+    m_prev     = std::exchange(other.m_prev, nullptr);
+    m_next     = std::exchange(other.m_next, nullptr);
+    m_slot     = std::exchange(other.m_slot, nullptr);
+    m_level    = other.m_level;
+    m_index    = other.m_index;
+    m_expiry   = other.m_expiry;
+    m_period   = other.m_period;
+    m_callback = other.m_callback;
+
+    if (!m_slot) return;
+    if (m_prev)
+        m_prev->m_next = this;
+    else
+        *m_slot = this;
+    if (m_next) m_next->m_prev = this;
+}
+
+TimerWheel::TimerWheel(Clock::Instant tick, Clock::Instant origin)
+    : m_tick(tick), m_origin(origin) {}
+
+auto TimerWheel::Start(
+    ipc::Callback<void> callback, Clock::Instant expiry, Clock::Instant period
+) -> Timer {
+    // Round up so that timers never fire early
+    const auto ticks {
+        expiry > m_origin ? (expiry - m_origin + m_tick - 1) / m_tick : 0
+    };
+    const auto period_ticks {
+        period ? std::max<Clock::Instant>((period + m_tick - 1) / m_tick, 1)
+               : 0
+    };
+
+    Timer timer(*this, callback, ticks, period_ticks);
+    {
+        // Returning may move the timer, which takes the lock again
+        std::scoped_lock lock(m_lock);
+        Insert(timer);
+    }
+    return timer;
+}
+
+auto TimerWheel::Advance(Clock::Instant now) -> std::size_t {
+    const auto now_ticks {now > m_origin ? (now - m_origin) / m_tick : 0};
+
+    std::size_t fired {0};
+    while (true) {
+        std::optional<ipc::Callback<void>> callback {};
+        {
+            std::scoped_lock lock(m_lock);
+            callback = PopExpired(now_ticks);
+        }
+
+        if (!callback) return fired;
+        (*callback)();
+        ++fired;
+    }
+}
+
+auto TimerWheel::NextExpiry() const -> std::optional<Clock::Instant> {
+    std::scoped_lock             lock(m_lock);
+    std::optional<std::uint64_t> next {};
+
+    for (std::size_t level {0}; level < kLevels; ++level) {
+        const auto occupied {m_occupied.at(level)};
+        if (!occupied) continue;
+
+        const auto shift {kBits * level};
+        const auto index {static_cast<int>((m_current >> shift) & kMask)};
+        std::uint64_t tick {0};
+        if (level == 0) {
+            // The current slot has not been processed yet
+            tick = m_current + std::countr_zero(std::rotr(occupied, index));
+        } else {
+            // Coarse slots are processed when their revolution begins
+            const auto ahead {
+                std::countr_zero(std::rotr(occupied, index + 1)) + 1
+            };
+            tick = ((m_current >> shift) + ahead) << shift;
+        }
+
+        next = std::min(next.value_or(tick), tick);
+    }
+
+    if (!next) return std::nullopt;
+    return m_origin + *next * m_tick;
+}
+
+auto TimerWheel::Insert(Timer& timer) -> void {
+    const auto expiry {std::max(timer.m_expiry, m_current)};
+
+    // Use the finest level in which the timer is less than one revolution
+    // away. The slot is cascaded when the level reaches it, at which point
+    // the timer is within one slot of that level.
+    std::size_t level {0};
+    while (level < kLevels &&
+           (expiry >> (kBits * level)) - (m_current >> (kBits * level)) >=
+               kSlots)
+        ++level;
+
+    std::uint64_t index {0};
+    if (level < kLevels) {
+        index = (expiry >> (kBits * level)) & kMask;
+    } else {
+        // Too far away, park it in the last slot of the top level to be
+        // re-inserted after a full revolution
+        level = kLevels - 1;
+        index = ((m_current >> (kBits * level)) - 1) & kMask;
+    }
+
+    auto& head {m_slots.at(level).at(index)};
+    timer.m_prev  = nullptr;
+    timer.m_next  = head;
+    timer.m_slot  = &head;
+    timer.m_level = static_cast<std::uint8_t>(level);
+    timer.m_index = static_cast<std::uint8_t>(index);
+    if (head) head->m_prev = &timer;
+    head = &timer;
+
+    m_occupied.at(level) |= std::uint64_t {1} << index;
+}
+
+auto TimerWheel::Unlink(Timer& timer) -> void {
+    if (timer.m_prev)
+        timer.m_prev->m_next = timer.m_next;
+    else
+        *timer.m_slot = timer.m_next;
+    if (timer.m_next) timer.m_next->m_prev = timer.m_prev;
+
+    if (!*timer.m_slot)
+        m_occupied.at(timer.m_level) &= ~(std::uint64_t {1} << timer.m_index);
+
+    timer.m_prev = nullptr;
+    timer.m_next = nullptr;
+    timer.m_slot = nullptr;
+}
+
+auto TimerWheel::Cascade() -> void {
+    // Higher levels first, as they may drop timers into the slots of lower
+    // levels which are due to be cascaded at the same boundary
+    for (auto level {kLevels - 1}; level > 0; --level) {
+        const auto shift {kBits * level};
+        if (m_current & ((std::uint64_t {1} << shift) - 1)) continue;
+
+        const auto index {(m_current >> shift) & kMask};
+        auto*      timer {std::exchange(m_slots.at(level).at(index), nullptr)};
+        m_occupied.at(level) &= ~(std::uint64_t {1} << index);
+
+        while (timer) {
+            auto* next {timer->m_next};
+            Insert(*timer);
+            timer = next;
+        }
+    }
+}
+
+auto TimerWheel::PopExpired(std::uint64_t now)
+    -> std::optional<ipc::Callback<void>> {
+    while (true) {
+        const auto index {m_current & kMask};
+        if (auto* timer {m_slots.at(0).at(index)}) {
+            Unlink(*timer);
+            const auto callback {timer->m_callback};
+
+            if (timer->m_period) {
+                auto& expiry {timer->m_expiry};
+                expiry += timer->m_period;
+                // Skip any firings which were missed entirely
+                if (expiry <= now)
+                    expiry += ((now - expiry) / timer->m_period + 1) *
+                              timer->m_period;
+                Insert(*timer);
+            }
+
+            return callback;
+        }
+
+        if (m_current >= now) return std::nullopt;
+
+        // Jump to the next occupied slot, the end of this revolution or now,
+        // whichever comes first
+        const auto    ahead {m_occupied.at(0) >> index};
+        std::uint64_t step {
+            ahead ? static_cast<std::uint64_t>(std::countr_zero(ahead))
+                  : kSlots - index
+        };
+        m_current += std::min(step, now - m_current);
+        if ((m_current & kMask) == 0) Cascade();
+    }
+}
+}  // namespace obc::scheduling
@@ -20,20 +20,181 @@
 
 #include "obc/sys/hosted/delay.hpp"
 
-#include <units/frequency.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include "obc/sys/hosted/sim.hpp"
 
 namespace obc::scheduling::detail {
-Timeout::Timeout(units::microseconds<float> period) {
-    // TODO(evan)
+namespace {
+/**
+ * Typical wake-up latency of a sleeping thread on a desktop Linux kernel (the
+ * default timer slack is 50us), the remainder of a wait is spent spinning.
+ */
+constexpr Clock::Instant kSpinWindow {100};
+
+/**
+ * Gets the current time rounded up to the next microsecond, so that relative
+ * timeouts started from it never elapse early when measured in real time.
+ */
+auto NowRoundedUp() -> Clock::Instant {
+    if (const auto* sim {Simulator::Active()}) return sim->Now();
+
+    return static_cast<Clock::Instant>(
+        std::chrono::ceil<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        )
+            .count()
+    );
+}
+
+auto ToTimePoint(Clock::Instant instant)
+    -> std::chrono::steady_clock::time_point {
+    return std::chrono::steady_clock::time_point(
+        std::chrono::microseconds(instant)
+    );
+}
+}  // namespace
+
+auto Clock::Now() -> Instant {
+    if (const auto* sim {Simulator::Active()}) return sim->Now();
+
+    return static_cast<Instant>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        )
+            .count()
+    );
+}
+
+Timeout::Timeout(Duration period) : Timeout(NowRoundedUp() + period) {}
+
+Timeout::Timeout(Clock::Instant deadline) : m_deadline(deadline) {}
+
+auto Timeout::Until(Clock::Instant deadline) -> Timeout {
+    return Timeout(deadline);
+}
+
+Timeout::operator bool() const {
+    return Clock::Now() >= m_deadline;
+}
+
+auto Timeout::Deadline() const -> Clock::Instant { return m_deadline; }
+
+auto Timeout::Block() -> void {
+    if (auto* sim {Simulator::Active()}) {
+        sim->SleepUntil(m_deadline);
+        return;
+    }
+
+    if (Clock::Now() + kSpinWindow < m_deadline)
+        std::this_thread::sleep_until(ToTimePoint(m_deadline - kSpinWindow));
+
+    while (!*this) {}
+}
+
+auto Timeout::Yield() -> void {
+    if (auto* sim {Simulator::Active()}) {
+        sim->YieldUntil(m_deadline);
+        return;
+    }
+
+    // Maps to sched_yield on POSIX hosts
+    std::this_thread::yield();
+}
+
+auto Timeout::Spin() -> void {
+    if (auto* sim {Simulator::Active()}) sim->YieldUntil(m_deadline);
+}
+
+auto Timeout::Sleep(Clock::Instant until) -> void {
+    until = std::min(until, m_deadline);
+
+    if (auto* sim {Simulator::Active()}) {
+        sim->SleepUntil(until);
+        return;
+    }
+
+    std::this_thread::sleep_until(ToTimePoint(until));
+}
+
+Notification::Notification(Slot& slot) : m_slot(&slot) {}
+
+// Each thread has its own notifications unless a task binds them for it
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+namespace {
+thread_local Notification::Slots* t_bound {nullptr};
+}  // namespace
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto Notification::Bind(Slots& slots) -> void { t_bound = &slots; }
+
+auto Notification::CurrentSlot(Index index) -> Slot& {
+    thread_local Slots slots {};
+    return (t_bound ? *t_bound : slots)[std::to_underlying(index)];
 }
 
-Timeout::operator bool() { return false; }
+auto Notification::Current() -> Notification {
+    return Notification(CurrentSlot(Index::kWait));
+}
+
+auto Notification::Give() -> void {
+    SimProcess* waiter {nullptr};
+    {
+        std::scoped_lock lock(m_slot->lock);
+        ++m_slot->pending;
+        waiter = m_slot->waiter;
+    }
+    m_slot->cv.notify_one();
+
+    if (auto* sim {Simulator::Active()}; sim && waiter) sim->Wake(*waiter);
+}
+
+auto Notification::GiveFromIsr() -> void { Give(); }
+
+auto Notification::GiveFromAny() -> void { Give(); }
+
+auto Notification::Take(Clock::Instant deadline, Index index) -> bool {
+    auto& slot {CurrentSlot(index)};
+
+    if (auto* sim {Simulator::Active()}) {
+        if (Simulator::Stopping()) throw TaskStopped {};
+        {
+            std::scoped_lock lock(slot.lock);
+            if (slot.pending) {
+                slot.pending = 0;
+                return true;
+            }
+            slot.waiter = Simulator::Current();
+        }
+
+        try {
+            sim->Block(deadline);
+        } catch (const TaskStopped&) {
+            std::scoped_lock lock(slot.lock);
+            slot.waiter = nullptr;
+            throw;
+        }
+
+        std::scoped_lock lock(slot.lock);
+        slot.waiter = nullptr;
+        return std::exchange(slot.pending, 0) != 0;
+    }
+
+    std::unique_lock lock(slot.lock);
+    slot.cv.wait_until(lock, ToTimePoint(deadline), [&] {
+        return slot.pending != 0 || slot.stopping;
+    });
+    if (slot.stopping) throw TaskStopped {};
 
-void Timeout::Block() {
-    // TODO(evan)
+    return std::exchange(slot.pending, 0) != 0;
 }
 
-void Timeout::Yield() {
-    // TODO(evan)
+auto Notification::Clear(Index index) -> void {
+    auto&            slot {CurrentSlot(index)};
+    std::scoped_lock lock(slot.lock);
+    slot.pending = 0;
 }
 }  // namespace obc::scheduling::detail
@@ -0,0 +1,52 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/ipc/doorbell.hpp"
+
+#include <array>
+#include <mutex>
+#include <optional>
+
+namespace obc::ipc {
+namespace {
+using Listeners =
+    std::array<std::optional<scheduling::Notification>, Doorbell::kCount>;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+Listeners  g_listeners {};
+std::mutex g_lock {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+
+auto Doorbell::Ring() const -> void {
+    std::scoped_lock lock(g_lock);
+    if (auto& listener {g_listeners.at(m_id)}) listener->Give();
+}
+
+auto Doorbell::Listen(scheduling::Notification listener) const -> void {
+    std::scoped_lock lock(g_lock);
+    g_listeners.at(m_id).emplace(listener);
+}
+
+auto Doorbell::Ignore() const -> void {
+    std::scoped_lock lock(g_lock);
+    g_listeners.at(m_id).reset();
+}
+}  // namespace obc::ipc
@@ -0,0 +1,106 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/ipc/profile.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace obc::ipc {
+#ifdef BALLOON_LOCK_PROFILING
+namespace {
+/**
+ * @brief Window with interrupts notionally masked on this thread.
+ */
+struct MaskWindow {
+    const void*   site {nullptr};
+    LockKind      kind {LockKind::kCritical};
+    std::uint32_t start {0};
+    std::uint32_t depth {0};
+};
+
+// Steady clock nanoseconds
+constexpr float kTicksPerMicrosecond {1'000.0F};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex              g_lock {};
+detail::LockSiteTable   g_table {};
+thread_local MaskWindow g_mask {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+
+namespace detail {
+auto ProfileNow() -> std::uint32_t {
+    const auto now {std::chrono::steady_clock::now().time_since_epoch()};
+    return static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()
+    );
+}
+
+auto RecordLock(
+    const void* site, LockKind kind, std::uint32_t wait, std::uint32_t hold,
+    bool contended
+) -> void {
+    std::scoped_lock lock(g_lock);
+    g_table.Record(site, kind, wait, hold, contended);
+}
+
+auto MaskBegin(const void* site, LockKind kind) -> void {
+    if (g_mask.depth++ > 0) return;
+    g_mask.site  = site;
+    g_mask.kind  = kind;
+    g_mask.start = ProfileNow();
+}
+
+auto MaskEnd() -> void {
+    if (--g_mask.depth > 0) return;
+    const auto window {ProfileNow() - g_mask.start};
+    std::scoped_lock lock(g_lock);
+    g_table.RecordMasked(g_mask.site, g_mask.kind, window);
+}
+}  // namespace detail
+
+auto LockProfile::Read(std::span<LockSiteStats> sites) -> std::size_t {
+    std::scoped_lock lock(g_lock);
+    return g_table.Read(sites, kTicksPerMicrosecond);
+}
+
+auto LockProfile::Dropped() -> std::uint32_t {
+    std::scoped_lock lock(g_lock);
+    return g_table.Dropped();
+}
+
+auto LockProfile::Reset() -> void {
+    std::scoped_lock lock(g_lock);
+    g_table = {};
+}
+#else
+auto LockProfile::Read(std::span<LockSiteStats> /*sites*/) -> std::size_t {
+    return 0;
+}
+
+auto LockProfile::Dropped() -> std::uint32_t { return 0; }
+
+auto LockProfile::Reset() -> void {}
+#endif
+}  // namespace obc::ipc
@@ -0,0 +1,243 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/sys/hosted/sim.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+namespace obc::scheduling::detail {
+namespace {
+/// Yields run after every other event due at the same time.
+constexpr int kYieldPriority {std::numeric_limits<int>::min()};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<Simulator*>  g_active {nullptr};
+thread_local SimProcess* t_current {nullptr};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+
+auto Simulator::Event::operator<(const Event& other) const -> bool {
+    if (time != other.time) return time > other.time;
+    if (priority != other.priority) return priority < other.priority;
+    return sequence > other.sequence;
+}
+
+Simulator::Simulator() {
+    [[maybe_unused]] const auto* previous {g_active.exchange(this)};
+    assert(previous == nullptr && "Only one simulator may exist at a time");
+}
+
+Simulator::~Simulator() {
+    for (const auto& process : m_processes) Stop(*process);
+    g_active.store(nullptr);
+}
+
+auto Simulator::Active() -> Simulator* { return g_active.load(); }
+
+auto Simulator::Current() -> SimProcess* { return t_current; }
+
+auto Simulator::Stopping() -> bool {
+    // Only set while the process is parked, so it is read after being resumed
+    return t_current && t_current->stopping;
+}
+
+auto Simulator::Now() const -> Clock::Instant {
+    return m_now.load(std::memory_order_relaxed);
+}
+
+auto Simulator::Events() const -> std::uint64_t {
+    return m_events.load(std::memory_order_relaxed);
+}
+
+auto Simulator::RunUntil(Clock::Instant end) -> void {
+    std::unique_lock lock(m_lock);
+    m_end = end;
+    if (auto* next {NextDue()}) {
+        Hand(next);
+        m_driver.wait(lock, [&] { return m_running == nullptr; });
+    }
+
+    m_now.store(std::max(Now(), end), std::memory_order_relaxed);
+}
+
+auto Simulator::Spawn(std::function<void()> body, int priority)
+    -> std::shared_ptr<SimProcess> {
+    auto process {std::make_shared<SimProcess>()};
+    process->priority = priority;
+
+    std::scoped_lock lock(m_lock);
+    m_processes.push_back(process);
+    Schedule(*process, Now(), priority);
+    process->thread = std::thread(
+        [this, &process = *process, body = std::move(body)] {
+            ProcessMain(process, body);
+        }
+    );
+    return process;
+}
+
+auto Simulator::Stop(SimProcess& process) -> void {
+    {
+        std::unique_lock lock(m_lock);
+        if (!process.finished) {
+            process.stopping = true;
+            Hand(&process);
+            m_driver.wait(lock, [&] { return m_running == nullptr; });
+        }
+    }
+
+    if (process.thread.joinable()) process.thread.join();
+}
+
+auto Simulator::SetPriority(SimProcess& process, int priority) -> void {
+    std::scoped_lock lock(m_lock);
+    process.priority = priority;
+    // Yields keep running after everything else
+    if (process.pending && process.due_priority != kYieldPriority)
+        Schedule(process, process.due, priority);
+}
+
+auto Simulator::SleepUntil(Clock::Instant deadline) -> void {
+    auto* process {t_current};
+    if (!process) {
+        RunUntil(deadline);
+        return;
+    }
+
+    std::unique_lock lock(m_lock);
+    Schedule(*process, std::max(deadline, Now()), process->priority);
+    Park(*process, lock);
+}
+
+auto Simulator::YieldUntil(Clock::Instant deadline) -> void {
+    std::unique_lock lock(m_lock);
+    auto next {deadline};
+    if (!m_queue.empty()) next = std::min(next, m_queue.top().time);
+    next = std::max(next, Now());
+
+    auto* process {t_current};
+    if (!process) {
+        lock.unlock();
+        RunUntil(next);
+        return;
+    }
+
+    Schedule(*process, next, kYieldPriority);
+    Park(*process, lock);
+}
+
+auto Simulator::Block(Clock::Instant deadline) -> bool {
+    auto* process {t_current};
+    if (!process) {
+        // Nothing can wake the driver, so it simply runs until the deadline
+        RunUntil(deadline);
+        return false;
+    }
+
+    std::unique_lock lock(m_lock);
+    process->blocked = true;
+    process->woken   = false;
+    Schedule(*process, std::max(deadline, Now()), process->priority);
+    Park(*process, lock);
+    process->blocked = false;
+    return process->woken;
+}
+
+auto Simulator::Wake(SimProcess& process) -> void {
+    std::scoped_lock lock(m_lock);
+    if (!process.blocked || process.woken) return;
+
+    process.woken = true;
+    Schedule(process, Now(), process.priority);
+}
+
+auto Simulator::Schedule(SimProcess& process, Clock::Instant time, int priority)
+    -> void {
+    m_queue.push({time, priority, m_sequence++, &process, ++process.generation}
+    );
+    process.due          = time;
+    process.due_priority = priority;
+    process.pending      = true;
+}
+
+auto Simulator::NextDue() -> SimProcess* {
+    while (!m_queue.empty() && m_queue.top().time <= m_end) {
+        const auto event {m_queue.top()};
+        m_queue.pop();
+
+        auto& process {*event.process};
+        if (process.finished || event.generation != process.generation)
+            continue;
+
+        process.pending = false;
+        m_now.store(std::max(Now(), event.time), std::memory_order_relaxed);
+        m_events.fetch_add(1, std::memory_order_relaxed);
+        return &process;
+    }
+
+    return nullptr;
+}
+
+auto Simulator::Hand(SimProcess* next) -> void {
+    m_running = next;
+    if (next)
+        next->resume.notify_one();
+    else
+        m_driver.notify_one();
+}
+
+auto Simulator::Park(SimProcess& process, std::unique_lock<std::mutex>& lock)
+    -> void {
+    // A stopping process keeps control while it unwinds, so every wait throws
+    if (process.stopping) throw TaskStopped {};
+
+    // Control passes directly between processes, the driver is only involved
+    // once nothing else is due before the end of the run
+    auto* next {NextDue()};
+    if (next != &process) {
+        Hand(next);
+        process.resume.wait(lock, [&] { return m_running == &process; });
+    }
+
+    if (process.stopping) throw TaskStopped {};
+}
+
+auto Simulator::ProcessMain(
+    SimProcess& process, const std::function<void()>& body
+) -> void {
+    t_current = &process;
+    {
+        std::unique_lock lock(m_lock);
+        process.resume.wait(lock, [&] { return m_running == &process; });
+    }
+
+    try {
+        if (!process.stopping) body();
+    } catch (const TaskStopped&) {}
+
+    std::scoped_lock lock(m_lock);
+    process.finished = true;
+    // A stopped process returns control to the driver which stopped it
+    Hand(process.stopping ? nullptr : NextDue());
+}
+}  // namespace obc::scheduling::detail
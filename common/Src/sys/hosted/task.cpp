@@ -0,0 +1,201 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/sys/hosted/task.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include <alloca.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "obc/sys/hosted/sim.hpp"
+
+namespace obc::scheduling::detail {
+namespace {
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex              g_start_lock {};
+std::condition_variable g_start_cv {};
+bool                    g_started {false};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+const auto g_epoch {std::chrono::steady_clock::now()};
+
+/// Byte which unused stack is painted with, as FreeRTOS does.
+constexpr std::byte   kStackPaint {0xa5};
+/// Least stack painted, as host frames are much larger than target ones.
+constexpr std::size_t kMinPaintSize {64 * 1024};
+
+/**
+ * @brief Paints an area of stack below the caller.
+ *
+ * The area is freed on returning, so the caller's callees grow into it.
+ *
+ * @param size Number of bytes to paint.
+ * @param paint Set to the lowest address painted.
+ */
+[[gnu::noinline]] auto PaintStack(
+    std::size_t size, std::atomic<std::byte*>& paint
+) -> void {
+    auto* area {static_cast<std::byte*>(alloca(size))};
+    std::memset(area, static_cast<int>(kStackPaint), size);
+    // The paint must not be elided for being dead on return
+    asm volatile("" : : "r"(area) : "memory");
+    paint = area;
+}
+
+/**
+ * @brief Counts the painted bytes which have since been overwritten.
+ *
+ * The stack belongs to another thread, which may still be running.
+ */
+[[gnu::no_sanitize_address, gnu::no_sanitize("thread")]] auto UsedPaint(
+    const std::byte* paint, std::size_t size
+) -> std::size_t {
+    std::size_t unused {0};
+    while (unused < size &&
+           static_cast<const volatile std::byte*>(paint)[unused] == kStackPaint)
+        ++unused;
+    return size - unused;
+}
+
+auto ReadCpuClock(clockid_t clock) -> Clock::Instant {
+    timespec time {};
+    if (clock_gettime(clock, &time) != 0) return 0;
+    return static_cast<Clock::Instant>(time.tv_sec) * 1'000'000 +
+           static_cast<Clock::Instant>(time.tv_nsec) / 1'000;
+}
+}  // namespace
+
+auto StartScheduler() -> void {
+    {
+        std::scoped_lock lock(g_start_lock);
+        g_started = true;
+    }
+    g_start_cv.notify_all();
+}
+
+auto UpTime() -> Clock::Instant {
+    return static_cast<Clock::Instant>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - g_epoch
+        )
+            .count()
+    );
+}
+
+auto IdleTime() -> Clock::Instant {
+    const auto elapsed {UpTime()};
+    return elapsed - std::min(elapsed, ReadCpuClock(CLOCK_PROCESS_CPUTIME_ID));
+}
+
+TaskControl::TaskControl(
+    std::span<StackWord> stack, const char* /*name*/, osPriority priority,
+    void (*entry)(void*), void* arg
+)
+    : m_paint_size(std::max(2 * stack.size_bytes(), kMinPaintSize)) {
+    auto body {[this, entry, arg] {
+        clockid_t clock {};
+        if (pthread_getcpuclockid(pthread_self(), &clock) == 0)
+            m_cpu_clock = clock;
+        m_tid = gettid();
+        PaintStack(m_paint_size, m_paint);
+        Notification::Bind(m_slots);
+        entry(arg);
+    }};
+
+    if (auto* sim {Simulator::Active()}) {
+        m_process = sim->Spawn(body, priority);
+        return;
+    }
+
+    m_thread = std::thread([this, body] {
+        {
+            std::unique_lock lock(g_start_lock);
+            g_start_cv.wait(lock, [this] {
+                return g_started || m_slots.front().stopping;
+            });
+            if (!g_started) return;
+        }
+
+        try {
+            body();
+        } catch (const TaskStopped&) {}
+    });
+}
+
+TaskControl::~TaskControl() {
+    if (m_process) {
+        // Otherwise the simulator has already stopped the process
+        if (auto* sim {Simulator::Active()}) sim->Stop(*m_process);
+        return;
+    }
+
+    {
+        std::scoped_lock lock(
+            g_start_lock, m_slots.front().lock, m_slots.back().lock
+        );
+        for (auto& slot : m_slots) slot.stopping = true;
+    }
+    g_start_cv.notify_all();
+    for (auto& slot : m_slots) slot.cv.notify_all();
+    m_thread.join();
+}
+
+auto TaskControl::CpuTime() const -> Clock::Instant {
+    if (!m_tid) return 0;
+    return ReadCpuClock(m_cpu_clock);
+}
+
+auto TaskControl::StackPeak() const -> std::size_t {
+    const auto* paint {m_paint.load()};
+    if (!paint) return 0;
+    return UsedPaint(paint, m_paint_size) / sizeof(StackWord);
+}
+
+auto TaskControl::SetPriority(osPriority priority) -> void {
+    if (auto* sim {Simulator::Active()}; sim && m_process)
+        sim->SetPriority(*m_process, priority);
+}
+
+auto TaskControl::ContextSwitches() const -> std::uint32_t {
+    const auto tid {m_tid.load()};
+    if (!tid) return 0;
+
+    // Linux reports voluntary and involuntary switches separately
+    std::ifstream status(
+        "/proc/self/task/" + std::to_string(tid) + "/status"
+    );
+    std::uint32_t switches {0};
+    for (std::string line; std::getline(status, line);) {
+        if (!line.contains("ctxt_switches:")) continue;
+        switches += static_cast<std::uint32_t>(
+            std::stoul(line.substr(line.find(':') + 1))
+        );
+    }
+    return switches;
+}
+}  // namespace obc::scheduling::detail
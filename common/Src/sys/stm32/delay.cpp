@@ -18,28 +18,195 @@
  */
 /* USER CODE END Header */
 
-#include "obc/sys/delay.hpp"
+#include "obc/sys/stm32/delay.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "obc/sys/stm32/task.hpp"
 
 #include <FreeRTOS.h>
+#include <stm32h7xx.h>
+#include <stm32h7xx_hal.h>
 #include <task.h>
-#include <units/frequency.h>
 
 namespace obc::scheduling::detail {
-Timeout::Timeout(units::microseconds<float> period)
-    : m_period(static_cast<TickType_t>(
-          (period / units::hertz<float>(configTICK_RATE_HZ)).value()
-      )) {
-    vTaskSetTimeOutState(&m_timeout);
+namespace {
+constexpr std::uint32_t kClockHz {1'000'000};
+constexpr std::uint64_t kTickPeriod {kClockHz / configTICK_RATE_HZ};
+/// Allowance for the latency between a tick and the woken task running.
+constexpr std::uint64_t kWakeMargin {50};
+/// Hardware semaphore serialising the start of TIM5 between the cores.
+constexpr std::uint32_t kStartSemaphore {31};
+
+// These are only accessed with interrupts disabled
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::uint32_t g_last_count {0};
+std::uint32_t g_wraps {0};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+/**
+ * @brief Gets the frequency of the clock feeding TIM5.
+ *
+ * APB1 timers run faster than PCLK1 when the bus clock is divided, by up to
+ * the divisor but no more than twice, or four times when RCC TIMPRE is set.
+ */
+auto TimerClockHz() -> std::uint32_t {
+    const std::uint32_t pclk1 {HAL_RCC_GetPCLK1Freq()};
+    const std::uint32_t ppre1 {
+        (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1) >> RCC_D2CFGR_D2PPRE1_Pos
+    };
+    // Divisors are encoded as 0b0xx for /1 and 0b1xx for /2 to /16
+    const std::uint32_t divisor {ppre1 < 0b100 ? 1U : 2U << (ppre1 - 0b100)};
+    const std::uint32_t limit {(RCC->CFGR & RCC_CFGR_TIMPRE) ? 4U : 2U};
+    return pclk1 * std::min(divisor, limit);
+}
+
+/**
+ * @brief Configures TIM5 as a free-running 1MHz counter, unless a core has
+ * already done so.
+ *
+ * Both cores read the same counter, so it must only ever be started once.
+ * Restarting it would move it backwards and appear to the other core as a
+ * wrap. Must be called with interrupts disabled.
+ */
+auto StartTimer() -> void {
+    __HAL_RCC_HSEM_CLK_ENABLE();
+    while (HAL_HSEM_FastTake(kStartSemaphore) != HAL_OK) {}
+
+    if (!(TIM5->CR1 & TIM_CR1_CEN)) {
+        __HAL_RCC_TIM5_CLK_ENABLE();
+        TIM5->CR1 = 0;
+        TIM5->PSC = TimerClockHz() / kClockHz - 1;
+        TIM5->ARR = UINT32_MAX;
+        // Latch the prescaler, this also resets the counter
+        TIM5->EGR = TIM_EGR_UG;
+        TIM5->CR1 = TIM_CR1_CEN;
+    }
+
+    HAL_HSEM_Release(kStartSemaphore, 0);
 }
 
-Timeout::operator bool() {
-    return xTaskCheckForTimeOut(&m_timeout, &m_period) == pdTRUE;
+/**
+ * @brief Gets the number of ticks which can be slept while remaining certain
+ * to wake before a deadline.
+ *
+ * Delaying for n ticks returns somewhere in the n-th tick from now, so only
+ * whole ticks (less an allowance for wake-up latency) are counted. The
+ * allowance grows by the measured cost of waking from tickless idle. Zero
+ * means the rest of the wait should be spent spinning.
+ *
+ * @param remaining Time until the deadline.
+ */
+auto SleepableTicks(std::uint64_t remaining) -> TickType_t {
+    const auto margin {kWakeMargin + WakeLatency()};
+    if (remaining < kTickPeriod + margin) return 0;
+    return static_cast<TickType_t>((remaining - margin) / kTickPeriod);
+}
+}  // namespace
+
+auto Clock::Now() -> Instant {
+    const std::uint32_t primask {__get_PRIMASK()};
+    __disable_irq();
+
+    // The other core may have already started the timer
+    if (!(TIM5->CR1 & TIM_CR1_CEN)) [[unlikely]]
+        StartTimer();
+
+    const std::uint32_t count {TIM5->CNT};
+    if (count < g_last_count) ++g_wraps;
+    g_last_count = count;
+    const Instant now {(static_cast<Instant>(g_wraps) << 32U) | count};
+
+    __set_PRIMASK(primask);
+    return now;
+}
+
+Timeout::Timeout(Duration period) : Timeout(Clock::Now() + period) {}
+
+Timeout::Timeout(Clock::Instant deadline) : m_deadline(deadline) {}
+
+auto Timeout::Until(Clock::Instant deadline) -> Timeout {
+    return Timeout(deadline);
 }
 
+Timeout::operator bool() const { return Clock::Now() >= m_deadline; }
+
+auto Timeout::Deadline() const -> Clock::Instant { return m_deadline; }
+
 auto Timeout::Block() -> void {
-    if (*this) return;
-    vTaskDelay(m_period);
+    for (auto now {Clock::Now()}; now < m_deadline; now = Clock::Now())
+        if (const auto ticks {SleepableTicks(m_deadline - now)})
+            vTaskDelay(ticks);
 }
 
 auto Timeout::Yield() -> void { taskYIELD(); }
+
+auto Timeout::Spin() -> void {}
+
+auto Timeout::Sleep(Clock::Instant until) -> void {
+    const auto now {Clock::Now()};
+    if (now >= until) return;
+
+    const auto limit {SleepableTicks(m_deadline - std::min(m_deadline, now))};
+    if (!limit) {
+        taskYIELD();
+        return;
+    }
+
+    const auto wanted {(until - now + kTickPeriod - 1) / kTickPeriod};
+    vTaskDelay(static_cast<TickType_t>(std::min<std::uint64_t>(wanted, limit)));
+}
+
+static_assert(
+    configTASK_NOTIFICATION_ARRAY_ENTRIES > 1,
+    "Blocking waits need a notification of their own"
+);
+
+Notification::Notification(TaskHandle_t task, Index index)
+    : m_task(task), m_index(index) {}
+
+auto Notification::Current() -> Notification {
+    return {xTaskGetCurrentTaskHandle(), Index::kWait};
+}
+
+auto Notification::Give() -> void {
+    xTaskNotifyGiveIndexed(m_task, std::to_underlying(m_index));
+}
+
+auto Notification::GiveFromIsr() -> void {
+    BaseType_t woken {pdFALSE};
+    vTaskNotifyGiveIndexedFromISR(m_task, std::to_underlying(m_index), &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+auto Notification::GiveFromAny() -> void {
+    // IPSR holds the number of the active exception, zero in thread mode
+    if (__get_IPSR()) {
+        GiveFromIsr();
+    } else {
+        Give();
+    }
+}
+
+auto Notification::Take(Clock::Instant deadline, Index index) -> bool {
+    for (auto now {Clock::Now()}; now < deadline; now = Clock::Now()) {
+        if (ulTaskNotifyTakeIndexed(
+                std::to_underlying(index), pdTRUE,
+                SleepableTicks(deadline - now)
+            ))
+            return true;
+    }
+
+    return false;
+}
+
+auto Notification::Clear(Index index) -> void {
+    ulTaskNotifyValueClearIndexed(
+        nullptr, std::to_underlying(index),
+        std::numeric_limits<std::uint32_t>::max()
+    );
+}
 }  // namespace obc::scheduling::detail
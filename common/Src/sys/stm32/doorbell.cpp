@@ -0,0 +1,103 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/ipc/doorbell.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "obc/ipc/mutex.hpp"
+
+#include <FreeRTOS.h>
+#include <stm32h7xx.h>
+#include <stm32h7xx_hal.h>
+
+namespace obc::ipc {
+namespace {
+#ifdef CORE_CM7
+constexpr IRQn_Type kIrq {HSEM1_IRQn};
+#else
+constexpr IRQn_Type kIrq {HSEM2_IRQn};
+#endif
+
+using Listeners =
+    std::array<std::optional<scheduling::Notification>, Doorbell::kCount>;
+
+// Written by tasks with interrupts masked, read by the HSEM interrupt
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+Listeners g_listeners {};
+IsrLock   g_lock {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+/**
+ * @brief Unmasks the HSEM interrupt of this core.
+ *
+ * Idempotent, so is simply repeated by every listener.
+ */
+auto EnableInterrupt() -> void {
+    __HAL_RCC_HSEM_CLK_ENABLE();
+    // Listeners are woken through FreeRTOS, so it must be maskable by it
+    HAL_NVIC_SetPriority(kIrq, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(kIrq);
+}
+}  // namespace
+
+auto Doorbell::Ring() const -> void {
+    // If the other core is part-way through ringing, its release wakes us
+    if (HAL_HSEM_FastTake(m_id) == HAL_OK) HAL_HSEM_Release(m_id, 0);
+}
+
+auto Doorbell::Listen(scheduling::Notification listener) const -> void {
+    EnableInterrupt();
+
+    std::scoped_lock lock(g_lock);
+    g_listeners.at(m_id).emplace(listener);
+    HAL_HSEM_ActivateNotification(__HAL_HSEM_SEMID_TO_MASK(m_id));
+}
+
+auto Doorbell::Ignore() const -> void {
+    std::scoped_lock lock(g_lock);
+    HAL_HSEM_DeactivateNotification(__HAL_HSEM_SEMID_TO_MASK(m_id));
+    g_listeners.at(m_id).reset();
+}
+}  // namespace obc::ipc
+
+/**
+ * @brief Called by `HAL_HSEM_IRQHandler` for semaphores released by the other
+ * core.
+ *
+ * @param mask Semaphores which were released.
+ */
+extern "C" auto HAL_HSEM_FreeCallback(std::uint32_t mask) -> void {
+    using obc::ipc::g_listeners;
+
+    for (auto pending {mask}; pending; pending &= pending - 1) {
+        const auto id {std::countr_zero(pending)};
+        auto&      listener {g_listeners.at(id)};
+        if (!listener) continue;
+
+        listener->GiveFromIsr();
+        // The HAL stops notifying of a semaphore once it fires
+        HAL_HSEM_ActivateNotification(__HAL_HSEM_SEMID_TO_MASK(id));
+    }
+}
@@ -23,27 +23,62 @@
 namespace obc::ipc {
 Mutex::Mutex() : m_handle {xSemaphoreCreateMutexStatic(&m_data)} {}
 
-auto Mutex::lock() -> void { xSemaphoreTake(m_handle, portMAX_DELAY); }
+auto Mutex::lock() -> void {
+    if constexpr (detail::kLockProfiling) {
+        const auto start {m_probe.Start()};
+        const bool contended {
+            xSemaphoreTake(m_handle, static_cast<TickType_t>(0)) != pdTRUE
+        };
+        if (contended) xSemaphoreTake(m_handle, portMAX_DELAY);
+        m_probe.Acquired(__builtin_return_address(0), start, contended);
+    } else {
+        xSemaphoreTake(m_handle, portMAX_DELAY);
+    }
+}
 
-auto Mutex::unlock() -> void { xSemaphoreGive(m_handle); }
+auto Mutex::unlock() -> void {
+    m_probe.Released(LockKind::kMutex);
+    xSemaphoreGive(m_handle);
+}
 
 auto Mutex::try_lock() -> bool {
-    return xSemaphoreTake(m_handle, static_cast<TickType_t>(0)) == pdTRUE;
+    const auto start {m_probe.Start()};
+    if (xSemaphoreTake(m_handle, static_cast<TickType_t>(0)) != pdTRUE)
+        return false;
+    m_probe.Acquired(__builtin_return_address(0), start, false);
+    return true;
 }
 
-CriticalGuard::CriticalGuard() { taskENTER_CRITICAL(); }
+CriticalGuard::CriticalGuard() {
+    taskENTER_CRITICAL();
+    const auto* site {__builtin_return_address(0)};
+    detail::MaskBegin(site, LockKind::kCritical);
+    m_probe.Acquired(site, m_probe.Start(), false);
+}
 
-CriticalGuard::~CriticalGuard() { taskEXIT_CRITICAL(); }
+CriticalGuard::~CriticalGuard() {
+    m_probe.Released(LockKind::kCritical);
+    detail::MaskEnd();
+    taskEXIT_CRITICAL();
+}
 
 auto SpinLock::lock() -> void {
     taskENTER_CRITICAL();
+    const auto* site {__builtin_return_address(0)};
+    detail::MaskBegin(site, LockKind::kSpinLock);
+    const auto start {m_probe.Start()};
+    bool       contended {false};
     while (m_lock.test_and_set(std::memory_order_acquire)) {
+        contended = true;
         while (m_lock.test(std::memory_order_relaxed)) {}
     }
+    m_probe.Acquired(site, start, contended);
 }
 
 auto SpinLock::unlock() -> void {
+    m_probe.Released(LockKind::kSpinLock);
     m_lock.clear(std::memory_order_release);
+    detail::MaskEnd();
     taskEXIT_CRITICAL();
 }
 
@@ -54,6 +89,22 @@ auto SpinLock::try_lock() -> bool {
         taskEXIT_CRITICAL();
         return false;
     }
+    const auto* site {__builtin_return_address(0)};
+    detail::MaskBegin(site, LockKind::kSpinLock);
+    m_probe.Acquired(site, m_probe.Start(), false);
     return true;
 }
+
+auto IsrLock::lock() -> void {
+    m_saved = taskENTER_CRITICAL_FROM_ISR();
+    const auto* site {__builtin_return_address(0)};
+    detail::MaskBegin(site, LockKind::kIsrLock);
+    m_probe.Acquired(site, m_probe.Start(), false);
+}
+
+auto IsrLock::unlock() -> void {
+    m_probe.Released(LockKind::kIsrLock);
+    detail::MaskEnd();
+    taskEXIT_CRITICAL_FROM_ISR(m_saved);
+}
 }  // namespace obc::ipc
@@ -0,0 +1,120 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/ipc/profile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <FreeRTOS.h>
+#include <stm32h7xx.h>
+#include <task.h>
+
+namespace obc::ipc {
+#ifdef BALLOON_LOCK_PROFILING
+namespace {
+/**
+ * @brief Window with interrupts masked on this core.
+ */
+struct MaskWindow {
+    const void*   site {nullptr};
+    LockKind      kind {LockKind::kCritical};
+    std::uint32_t start {0};
+    std::uint32_t depth {0};
+};
+
+// Each core links its own copy, so these are per core. Only accessed with
+// interrupts masked.
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+detail::LockSiteTable g_table {};
+MaskWindow            g_mask {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+/**
+ * @brief Gets the rate of the cycle counter.
+ */
+auto TicksPerMicrosecond() -> float {
+    return static_cast<float>(SystemCoreClock) / 1'000'000.0F;
+}
+}  // namespace
+
+namespace detail {
+auto ProfileNow() -> std::uint32_t {
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) [[unlikely]] {
+        // Enabled on first use, as the debugger may not have done so
+        CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT      = 0;
+        DWT->CTRL        = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+
+auto RecordLock(
+    const void* site, LockKind kind, std::uint32_t wait, std::uint32_t hold,
+    bool contended
+) -> void {
+    const auto saved {taskENTER_CRITICAL_FROM_ISR()};
+    g_table.Record(site, kind, wait, hold, contended);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+auto MaskBegin(const void* site, LockKind kind) -> void {
+    if (g_mask.depth++ > 0) return;
+    g_mask.site  = site;
+    g_mask.kind  = kind;
+    g_mask.start = ProfileNow();
+}
+
+auto MaskEnd() -> void {
+    if (--g_mask.depth > 0) return;
+    g_table.RecordMasked(g_mask.site, g_mask.kind, ProfileNow() - g_mask.start);
+}
+}  // namespace detail
+
+auto LockProfile::Read(std::span<LockSiteStats> sites) -> std::size_t {
+    const auto saved {taskENTER_CRITICAL_FROM_ISR()};
+    const auto count {g_table.Read(sites, TicksPerMicrosecond())};
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    return count;
+}
+
+auto LockProfile::Dropped() -> std::uint32_t {
+    const auto saved {taskENTER_CRITICAL_FROM_ISR()};
+    const auto dropped {g_table.Dropped()};
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    return dropped;
+}
+
+auto LockProfile::Reset() -> void {
+    const auto saved {taskENTER_CRITICAL_FROM_ISR()};
+    g_table = {};
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+#else
+auto LockProfile::Read(std::span<LockSiteStats> /*sites*/) -> std::size_t {
+    return 0;
+}
+
+auto LockProfile::Dropped() -> std::uint32_t { return 0; }
+
+auto LockProfile::Reset() -> void {}
+#endif
+}  // namespace obc::ipc
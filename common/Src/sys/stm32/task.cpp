@@ -0,0 +1,181 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include "obc/sys/stm32/task.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include <FreeRTOS.h>
+#include <stm32h7xx.h>
+#include <task.h>
+
+namespace obc::scheduling::detail {
+namespace {
+constexpr Clock::Instant kTickPeriod {1'000'000 / configTICK_RATE_HZ};
+/// Each faster wake moves the latency estimate 1/2^n of the way down to it.
+constexpr unsigned       kLatencyDecayShift {3};
+
+// These are only accessed by the context switch, or with it masked
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+Clock::Instant g_started {0};
+Clock::Instant g_switched {0};
+Clock::Instant g_idle {0};
+TaskHandle_t   g_switched_out {nullptr};
+SleepStats     g_sleep {};
+Clock::Instant g_sleep_start {0};
+/// End of the last full length sleep, until a task has run after it.
+Clock::Instant g_wake_due {0};
+
+std::atomic<std::uint32_t> g_wake_latency {0};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto RunTimeOf(TaskHandle_t task) -> RunTime* {
+    return static_cast<RunTime*>(
+        pvTaskGetThreadLocalStoragePointer(task, kRunTimeSlot)
+    );
+}
+}  // namespace
+
+auto StartScheduler() -> void {
+    g_started  = Clock::Now();
+    g_switched = g_started;
+    vTaskStartScheduler();
+    __builtin_unreachable();
+}
+
+auto UpTime() -> Clock::Instant { return Clock::Now() - g_started; }
+
+auto IdleTime() -> Clock::Instant {
+    taskENTER_CRITICAL();
+    const auto idle {g_idle};
+    taskEXIT_CRITICAL();
+    return idle;
+}
+
+auto Residency() -> SleepStats {
+    taskENTER_CRITICAL();
+    auto sleep {g_sleep};
+    taskEXIT_CRITICAL();
+    return sleep;
+}
+
+auto WakeLatency() -> Clock::Instant {
+    return g_wake_latency.load(std::memory_order_relaxed);
+}
+
+auto TaskControl::CpuTime() const -> Clock::Instant {
+    taskENTER_CRITICAL();
+    auto cpu {m_run_time.cpu};
+    // Include the slice in progress if the task is reading its own time
+    if (m_handle == xTaskGetCurrentTaskHandle())
+        cpu += Clock::Now() - g_switched;
+    taskEXIT_CRITICAL();
+    return cpu;
+}
+
+auto TaskControl::ContextSwitches() const -> std::uint32_t {
+    taskENTER_CRITICAL();
+    const auto switches {m_run_time.switches};
+    taskEXIT_CRITICAL();
+    return switches;
+}
+
+auto TaskControl::StackPeak() const -> std::size_t {
+    return m_depth - uxTaskGetStackHighWaterMark(m_handle);
+}
+
+auto TaskControl::SetPriority(osPriority priority) -> void {
+    vTaskPrioritySet(m_handle, priority);
+}
+}  // namespace obc::scheduling::detail
+
+// Context switch hooks, called by the kernel with interrupts masked
+// NOLINTBEGIN(readability-identifier-naming)
+extern "C" auto obc_task_switched_out() -> void {
+    using namespace obc::scheduling::detail;
+
+    const auto now {Clock::Now()};
+    const auto slice {now - g_switched};
+    g_switched     = now;
+    g_switched_out = xTaskGetCurrentTaskHandle();
+
+    if (g_switched_out == xTaskGetIdleTaskHandle())
+        g_idle += slice;
+    else if (auto* run_time {RunTimeOf(g_switched_out)})
+        run_time->cpu += slice;
+}
+
+extern "C" auto obc_task_switched_in() -> void {
+    using namespace obc::scheduling::detail;
+
+    auto* task {xTaskGetCurrentTaskHandle()};
+    if (g_wake_due && task != xTaskGetIdleTaskHandle()) {
+        const auto late {g_switched - std::min(g_switched, g_wake_due)};
+        const auto latency {static_cast<std::uint32_t>(
+            std::min(late, kTickPeriod)
+        )};
+        g_sleep.wake_latency = std::max<Clock::Instant>(
+            g_sleep.wake_latency, latency
+        );
+
+        // Worse wakes are allowed for at once, but the estimate decays back
+        // afterwards, so that one slow wake does not shorten every later sleep
+        auto estimate {g_wake_latency.load(std::memory_order_relaxed)};
+        if (latency >= estimate) {
+            estimate = latency;
+        } else {
+            // Rounded up, so the estimate does reach the latency
+            constexpr std::uint32_t kRound {(1U << kLatencyDecayShift) - 1};
+            estimate -= (estimate - latency + kRound) >> kLatencyDecayShift;
+        }
+        g_wake_latency.store(estimate, std::memory_order_relaxed);
+        g_wake_due = 0;
+    }
+
+    if (task == g_switched_out) return;
+    if (auto* run_time {RunTimeOf(task)}) ++run_time->switches;
+}
+
+// Tickless idle hooks, called by the idle task with interrupts masked
+extern "C" auto obc_pre_sleep(std::uint32_t* /*expected*/) -> void {
+    using namespace obc::scheduling::detail;
+
+    // By now the port has restarted SysTick to fire when the sleep is due to
+    // end, which may be part way through a tick
+    const std::uint64_t cycles {SysTick->VAL ? SysTick->VAL : SysTick->LOAD};
+    g_sleep_start = Clock::Now();
+    g_wake_due    = g_sleep_start + cycles * 1'000'000 / configCPU_CLOCK_HZ;
+}
+
+extern "C" auto obc_post_sleep(std::uint32_t /*expected*/) -> void {
+    using namespace obc::scheduling::detail;
+
+    const auto now {Clock::Now()};
+    ++g_sleep.sleeps;
+    g_sleep.asleep += now - g_sleep_start;
+    // Woken by some other interrupt, so the wake-up latency is not measurable
+    if (now < g_wake_due) {
+        ++g_sleep.early_wakes;
+        g_wake_due = 0;
+    }
+}
+// NOLINTEND(readability-identifier-naming)
@@ -0,0 +1,130 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/bus/await.hpp>
+#include <obc/mock/bus.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+using obc::bus::BasicMessage;
+using obc::bus::ReceivedMessage;
+using obc::bus::mock::MockListenBus;
+using obc::bus::mock::MockSendBus;
+using obc::scheduling::Coroutine;
+using obc::scheduling::Executor;
+
+namespace {
+constexpr std::size_t kFrameSize {256};
+
+/**
+ * @brief Executor polled by the test rather than by a task.
+ */
+class ManualExecutor
+    : private obc::scheduling::internal::FrameStorage<2 * kFrameSize>,
+      public Executor {
+  public:
+    ManualExecutor() : Executor(this->frames, kFrameSize) {}
+
+    auto Wake() -> void override {}
+
+    using Executor::Poll;
+};
+
+auto Receive(
+    Executor& /*executor*/, MockListenBus<>& bus,
+    std::optional<ReceivedMessage<4>>& out
+) -> Coroutine {
+    auto msg {co_await obc::bus::NextMessage<4>(bus)};
+    if (msg) out = *msg;
+}
+
+auto Send(
+    Executor& /*executor*/, MockSendBus<>& bus, BasicMessage msg, bool& sent
+) -> Coroutine {
+    sent = (co_await obc::bus::SendAndWait(bus, msg)).has_value();
+}
+}  // namespace
+
+TEST(BusAwait, ResumesWithNextMessage) {
+    ManualExecutor                    executor {};
+    MockListenBus<>                   bus {};
+    std::optional<ReceivedMessage<4>> out {};
+
+    std::array<std::byte, 6> first {std::byte {1}, std::byte {2},
+                                    std::byte {3}, std::byte {4},
+                                    std::byte {5}, std::byte {6}};
+    std::array<std::byte, 1> second {std::byte {9}};
+
+    ASSERT_TRUE(Receive(executor, bus, out));
+    // Messages before the coroutine waits are not received
+    bus.PushListenMessage({0x10, second});
+    executor.Poll();
+    EXPECT_EQ(bus.Listeners(), 1);
+
+    // Only the first message is kept, truncated to the payload size
+    bus.PushListenMessage({0x42, first});
+    bus.PushListenMessage({0x43, second});
+    EXPECT_FALSE(out);
+
+    executor.Poll();
+    ASSERT_TRUE(out);
+    EXPECT_EQ(out->address, 0x42);
+    EXPECT_EQ(out->size, 4);
+    EXPECT_EQ(out->payload.at(3), std::byte {4});
+    EXPECT_EQ(bus.Listeners(), 0);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+}
+
+TEST(BusAwait, ResumesOnceSendCompletes) {
+    ManualExecutor           executor {};
+    MockSendBus<>            bus {};
+    std::array<std::byte, 2> payload {};
+    bool                     sent {false};
+
+    ASSERT_TRUE(Send(executor, bus, {0x42, payload}, sent));
+    executor.Poll();
+    ASSERT_EQ(bus.sent.size(), 1);
+    EXPECT_EQ(bus.sent.at(0).address, 0x42);
+
+    executor.Poll();
+    EXPECT_FALSE(sent);
+
+    bus.CompleteSends();
+    executor.Poll();
+    EXPECT_TRUE(sent);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+}
+
+TEST(BusAwait, ContinuesWhenSendCompletesImmediately) {
+    ManualExecutor           executor {};
+    MockSendBus<>            bus {};
+    std::array<std::byte, 2> payload {};
+    bool                     sent {false};
+
+    bus.complete_immediately = true;
+    ASSERT_TRUE(Send(executor, bus, {0x42, payload}, sent));
+    executor.Poll();
+    EXPECT_TRUE(sent);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+}
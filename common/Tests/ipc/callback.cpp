@@ -0,0 +1,130 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/callback.hpp>
+#include <obc/scheduling/simulation.hpp>
+#include <obc/scheduling/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::AsyncValue;
+using obc::ipc::Await;
+using obc::scheduling::Clock;
+using obc::scheduling::Simulation;
+using obc::scheduling::StackTask;
+using obc::scheduling::WakeReason;
+namespace wait = obc::scheduling::wait;
+
+/**
+ * @brief Waits in every run for a value, which a \ref Setter sets.
+ */
+class Waiter : public StackTask<256> {
+  public:
+    Waiter() : StackTask("Waiter", units::milliseconds<float>(100)) {}
+
+    /// Value currently waited for, if any.
+    std::atomic<AsyncValue<int>*> pending {nullptr};
+    int                           values {0};
+    int                           events {0};
+
+  protected:
+    auto Run(WakeReason reason) -> void override {
+        if (reason == WakeReason::kEvent) ++events;
+
+        AsyncValue<int> value {};
+        pending = &value;
+        if (value.Wait(units::milliseconds<float>(50))) ++values;
+        pending = nullptr;
+    }
+};
+
+/**
+ * @brief Sets the value a \ref Waiter is waiting for.
+ */
+class Setter : public StackTask<256> {
+  public:
+    explicit Setter(Waiter& waiter)
+        : StackTask("Setter", units::milliseconds<float>(10), osPriorityHigh),
+          m_waiter(waiter) {}
+
+  protected:
+    auto Run(WakeReason /*reason*/) -> void override {
+        if (auto* value {m_waiter.pending.exchange(nullptr)}) value->Set(1);
+    }
+
+  private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Waiter& m_waiter;
+};
+}  // namespace
+
+TEST(AsyncValue, WaitSleepsUntilSet) {
+    const auto      before {wait::Notify::Stats().Read()};
+    AsyncValue<int> value {};
+    std::thread setter {[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        value.Set(3);
+    }};
+
+    const auto result {value.Wait(units::seconds<float>(5))};
+    setter.join();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->get(), 3);
+
+    // Woken by the notification rather than by polling
+    const auto after {wait::Notify::Stats().Read()};
+    EXPECT_LE(after.polls - before.polls, 3);
+}
+
+TEST(AsyncValue, WaitLeavesTaskLoopAlone) {
+    Simulation sim {};
+    Waiter     waiter {};
+    Setter     setter {waiter};
+
+    sim.RunUntil(Clock::Instant {950'000});
+    EXPECT_EQ(waiter.values, 10);
+    // The notification which ended each wait does not also wake the loop
+    EXPECT_EQ(waiter.events, 0);
+}
+
+TEST(AsyncValue, AwaitTimesOut) {
+    const auto start {std::chrono::steady_clock::now()};
+    const auto result {Await<int>(
+        [](AsyncValue<int>& /*value*/) {}, units::milliseconds<float>(10)
+    )};
+    EXPECT_EQ(result, std::nullopt);
+    EXPECT_GE(
+        std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10)
+    );
+}
+
+TEST(AsyncValue, AwaitReturnsValueSetImmediately) {
+    const auto result {Await<int>(
+        [](AsyncValue<int>& value, int x) { value.Set(x); },
+        units::milliseconds<float>(10), 42
+    )};
+    EXPECT_EQ(result, 42);
+}
@@ -0,0 +1,88 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/channel.hpp>
+
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::CoreChannel;
+using obc::ipc::Doorbell;
+
+struct Message {
+    std::uint32_t sequence;
+    std::uint32_t payload;
+};
+}  // namespace
+
+TEST(CoreChannel, PassesMessagesInPlace) {
+    CoreChannel<Message, 4> channel {};
+    channel.Reset(Doorbell(1), Doorbell(2));
+    EXPECT_EQ(channel.TryPeek(), nullptr);
+
+    auto* slot {channel.TryReserve()};
+    ASSERT_NE(slot, nullptr);
+    slot->payload = 42;
+    channel.Commit();
+
+    // The consumer reads the very slot the producer wrote
+    const auto* message {channel.TryPeek()};
+    EXPECT_EQ(message, slot);
+    EXPECT_EQ(message->payload, 42);
+    channel.Release();
+
+    for (int i {0}; i < 4; ++i) {
+        ASSERT_NE(channel.TryReserve(), nullptr);
+        channel.Commit();
+    }
+    EXPECT_EQ(channel.TryReserve(), nullptr);
+    EXPECT_EQ(channel.Reserve(units::milliseconds<float>(5)), nullptr);
+    EXPECT_EQ(channel.Size(), 4);
+}
+
+TEST(CoreChannel, ConnectsTwoCores) {
+    constexpr std::uint32_t kMessages {50'000};
+
+    CoreChannel<Message, 8> channel {};
+    channel.Reset(Doorbell(1), Doorbell(2));
+
+    // Each thread stands in for one core
+    std::thread acquisition {[&] {
+        for (std::uint32_t i {0}; i < kMessages; ++i) {
+            auto* slot {channel.Reserve(units::seconds<float>(5))};
+            ASSERT_NE(slot, nullptr);
+            *slot = {.sequence = i, .payload = i * 3};
+            channel.Commit();
+        }
+    }};
+
+    for (std::uint32_t i {0}; i < kMessages; ++i) {
+        const auto* message {channel.Peek(units::seconds<float>(5))};
+        ASSERT_NE(message, nullptr);
+        ASSERT_EQ(message->sequence, i);
+        ASSERT_EQ(message->payload, i * 3);
+        channel.Release();
+    }
+    acquisition.join();
+    EXPECT_EQ(channel.Size(), 0);
+}
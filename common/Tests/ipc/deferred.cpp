@@ -0,0 +1,101 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/deferred.hpp>
+#include <obc/scheduling/delay.hpp>
+#include <obc/scheduling/simulation.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::ipc::DeferredExecutor;
+using obc::scheduling::Clock;
+using obc::scheduling::Simulation;
+using obc::scheduling::Timeout;
+
+namespace {
+constexpr Clock::Instant kMillisecond {1'000};
+
+/**
+ * @brief Records the time of each piece of work it is given.
+ */
+struct Worker {
+    std::vector<Clock::Instant> runs {};
+    units::microseconds<float>  busy {0};
+
+    auto Work() -> void {
+        runs.push_back(Clock::Now());
+        if (busy.value() > 0) Timeout(busy).Block();
+    }
+};
+}  // namespace
+
+TEST(DeferredExecutor, RunsWorkInOrder) {
+    Simulation          sim {};
+    DeferredExecutor<4> executor {};
+    Worker              first {};
+    Worker              second {};
+
+    sim.RunUntil(kMillisecond);
+    EXPECT_TRUE(executor.DeferFromIsr(OBC_CALLBACK_METHOD(first, Work)));
+    EXPECT_TRUE(executor.Defer(OBC_CALLBACK_METHOD(second, Work)));
+    sim.RunUntil(2 * kMillisecond);
+
+    ASSERT_EQ(first.runs.size(), 1);
+    ASSERT_EQ(second.runs.size(), 1);
+    // Run as soon as deferred, rather than at the executor's next period
+    EXPECT_EQ(first.runs.front(), kMillisecond);
+    EXPECT_EQ(executor.Stats().deferred, 2);
+}
+
+TEST(DeferredExecutor, DropsWorkWhenFull) {
+    Simulation          sim {};
+    DeferredExecutor<4> executor {};
+    Worker              worker {};
+
+    for (int i {0}; i < 6; ++i)
+        executor.DeferFromIsr(OBC_CALLBACK_METHOD(worker, Work));
+    sim.RunUntil(kMillisecond);
+
+    const auto stats {executor.Stats()};
+    EXPECT_EQ(worker.runs.size(), 4);
+    EXPECT_EQ(stats.deferred, 4);
+    EXPECT_EQ(stats.overflows, 2);
+    EXPECT_EQ(stats.high_water, 4);
+}
+
+TEST(DeferredExecutor, MeasuresLatency) {
+    Simulation          sim {};
+    DeferredExecutor<4> executor {};
+    Worker              worker {.busy = units::microseconds<float>(300)};
+
+    sim.RunUntil(kMillisecond);
+    executor.DeferFromIsr(OBC_CALLBACK_METHOD(worker, Work));
+    executor.DeferFromIsr(OBC_CALLBACK_METHOD(worker, Work));
+    sim.RunUntil(2 * kMillisecond);
+
+    // The second item waited for the first to finish
+    const auto latency {executor.Stats().latency};
+    EXPECT_EQ(latency.runs, 2);
+    EXPECT_FLOAT_EQ(latency.mean.value(), 300);
+    EXPECT_EQ(latency.histogram.at(9), 1);
+    EXPECT_EQ(latency.histogram.at(10), 1);
+}
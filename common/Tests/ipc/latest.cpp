@@ -0,0 +1,86 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/latest.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+struct Snapshot {
+    std::array<std::uint32_t, 5> fields;
+    std::uint8_t                 flags;
+};
+
+auto Uniform(std::uint32_t value) -> Snapshot {
+    Snapshot snapshot {};
+    snapshot.fields.fill(value);
+    snapshot.flags = static_cast<std::uint8_t>(value);
+    return snapshot;
+}
+}  // namespace
+
+TEST(Latest, ReadsLastWrite) {
+    obc::ipc::Latest<Snapshot> latest {Uniform(3)};
+    EXPECT_EQ(latest.Read().fields[4], 3);
+    EXPECT_EQ(latest.Writes(), 0);
+
+    latest.Write(Uniform(4));
+    latest.Write(Uniform(5));
+    EXPECT_EQ(latest.Read().fields[0], 5);
+    EXPECT_EQ(latest.Read().flags, 5);
+    EXPECT_EQ(latest.Writes(), 2);
+}
+
+TEST(Latest, NeverReadsTornValue) {
+    constexpr std::uint32_t kWrites {200'000};
+
+    obc::ipc::Latest<Snapshot> latest {};
+    std::atomic<bool>          done {false};
+
+    std::thread writer {[&] {
+        for (std::uint32_t i {1}; i <= kWrites; ++i) {
+            latest.Write(Uniform(i));
+            if (i % 64 == 0) std::this_thread::yield();
+        }
+        done = true;
+    }};
+
+    std::uint32_t last {0};
+    while (!done) {
+        const auto snapshot {latest.Read()};
+        for (const auto field : snapshot.fields)
+            ASSERT_EQ(field, snapshot.fields[0]);
+        ASSERT_EQ(
+            snapshot.flags, static_cast<std::uint8_t>(snapshot.fields[0])
+        );
+
+        // Values never go backwards
+        ASSERT_GE(snapshot.fields[0], last);
+        last = snapshot.fields[0];
+        std::this_thread::yield();
+    }
+    writer.join();
+    EXPECT_EQ(latest.Read().fields[0], kWrites);
+}
@@ -0,0 +1,111 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/mutex.hpp>
+#include <obc/ipc/profile.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::LockKind;
+using obc::ipc::LockSiteStats;
+
+// Stand-in sites, only compared by address
+constexpr std::array<int, 2> kSites {};
+}  // namespace
+
+TEST(LockProfile, AccumulatesPerSite) {
+    obc::ipc::detail::LockSiteTable table {};
+    table.Record(&kSites[0], LockKind::kSpinLock, 10, 100, false);
+    table.Record(&kSites[0], LockKind::kSpinLock, 30, 300, true);
+    table.Record(&kSites[1], LockKind::kMutex, 0, 50, false);
+    table.RecordMasked(&kSites[0], LockKind::kSpinLock, 500);
+    table.RecordMasked(&kSites[0], LockKind::kSpinLock, 400);
+
+    std::array<LockSiteStats, 4> sites {};
+    ASSERT_EQ(table.Read(sites, 10.0F), 2);
+
+    EXPECT_EQ(sites[0].site, &kSites[0]);
+    EXPECT_EQ(sites[0].kind, LockKind::kSpinLock);
+    EXPECT_EQ(sites[0].acquisitions, 2);
+    EXPECT_EQ(sites[0].contended, 1);
+    EXPECT_FLOAT_EQ(sites[0].mean_wait.value(), 2.0F);
+    EXPECT_FLOAT_EQ(sites[0].max_wait.value(), 3.0F);
+    EXPECT_FLOAT_EQ(sites[0].mean_hold.value(), 20.0F);
+    EXPECT_FLOAT_EQ(sites[0].max_hold.value(), 30.0F);
+    EXPECT_FLOAT_EQ(sites[0].max_masked.value(), 50.0F);
+
+    EXPECT_EQ(sites[1].site, &kSites[1]);
+    EXPECT_EQ(sites[1].acquisitions, 1);
+    EXPECT_FLOAT_EQ(sites[1].max_masked.value(), 0.0F);
+}
+
+TEST(LockProfile, DropsSitesBeyondCapacity) {
+    std::array<int, obc::ipc::LockProfile::kSites + 1> many {};
+
+    obc::ipc::detail::LockSiteTable table {};
+    for (const auto& site : many)
+        table.Record(&site, LockKind::kMutex, 0, 1, false);
+    table.Record(&many.back(), LockKind::kMutex, 0, 1, false);
+
+    std::array<LockSiteStats, obc::ipc::LockProfile::kSites + 1> sites {};
+    EXPECT_EQ(table.Read(sites, 1.0F), obc::ipc::LockProfile::kSites);
+    EXPECT_EQ(table.Dropped(), 2);
+}
+
+#ifdef BALLOON_LOCK_PROFILING
+TEST(LockProfile, RecordsContendedMutex) {
+    using namespace std::chrono_literals;
+
+    obc::ipc::LockProfile::Reset();
+    obc::ipc::Mutex lock {};
+
+    std::unique_lock held(lock);
+    std::thread      waiter {[&] { std::scoped_lock waiting(lock); }};
+    std::this_thread::sleep_for(20ms);
+    held.unlock();
+    waiter.join();
+
+    std::array<LockSiteStats, obc::ipc::LockProfile::kSites> sites {};
+    const auto count {obc::ipc::LockProfile::Read(sites)};
+
+    std::size_t acquisitions {0};
+    std::size_t contended {0};
+    for (std::size_t i {0}; i < count; ++i) {
+        if (sites[i].kind != LockKind::kMutex) continue;
+        acquisitions += sites[i].acquisitions;
+        contended    += sites[i].contended;
+        // Both waited on and held for the sleep, in microseconds
+        if (sites[i].contended) {
+            EXPECT_GT(sites[i].max_wait.value(), 10'000);
+        } else {
+            EXPECT_GT(sites[i].max_hold.value(), 10'000);
+        }
+    }
+    EXPECT_EQ(acquisitions, 2);
+    EXPECT_EQ(contended, 1);
+}
+#endif
@@ -0,0 +1,93 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::ipc::MpmcQueue;
+
+TEST(MpmcQueue, IsBoundedFifo) {
+    MpmcQueue<int, 4> queue {};
+    for (int i {0}; i < 4; ++i) EXPECT_TRUE(queue.TryPush(i));
+    EXPECT_FALSE(queue.TryPush(4));
+    EXPECT_EQ(queue.Size(), 4);
+
+    for (int i {0}; i < 4; ++i) EXPECT_EQ(queue.TryPop(), i);
+    EXPECT_EQ(queue.TryPop(), std::nullopt);
+}
+
+TEST(MpmcQueue, DeliversEveryElementOnce) {
+    constexpr int          kProducers {4};
+    constexpr int          kConsumers {4};
+    constexpr std::int64_t kPerProducer {20'000};
+
+    MpmcQueue<std::int64_t, 16> queue {};
+    std::atomic<std::int64_t>   sum {0};
+    std::atomic<std::int64_t>   received {0};
+
+    std::vector<std::thread> threads {};
+    for (int p {0}; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (std::int64_t i {0}; i < kPerProducer; ++i)
+                while (!queue.TryPush(p * kPerProducer + i))
+                    std::this_thread::yield();
+        });
+    }
+    for (int c {0}; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            while (received.load() < kProducers * kPerProducer) {
+                if (auto value {queue.TryPop()}) {
+                    sum += *value;
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto total {kProducers * kPerProducer};
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST(MpmcQueue, BlockingPopWakesOnPush) {
+    MpmcQueue<int, 4> queue {};
+    EXPECT_EQ(queue.Pop(units::milliseconds<float>(5)), std::nullopt);
+
+    std::thread producer {[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.TryPush(7);
+    }};
+
+    const auto start {std::chrono::steady_clock::now()};
+    EXPECT_EQ(queue.Pop(units::seconds<float>(5)), 7);
+    EXPECT_LT(
+        std::chrono::steady_clock::now() - start, std::chrono::seconds(1)
+    );
+    producer.join();
+}
@@ -0,0 +1,89 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/ring.hpp>
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::ipc::SpscRing;
+using obc::ipc::StaticSpscRing;
+
+TEST(SpscRing, PushesAndPopsInOrder) {
+    StaticSpscRing<int, 4> ring {};
+    EXPECT_TRUE(ring.Empty());
+    for (int i {0}; i < 4; ++i) EXPECT_TRUE(ring.TryPush(i));
+    EXPECT_FALSE(ring.TryPush(4));
+    EXPECT_EQ(ring.Size(), 4);
+
+    for (int i {0}; i < 4; ++i) EXPECT_EQ(ring.TryPop(), i);
+    EXPECT_EQ(ring.TryPop(), std::nullopt);
+}
+
+TEST(SpscRing, BulkTransfersWrapAround) {
+    std::array<int, 8> storage {};
+    SpscRing<int, 8>   ring {storage};
+
+    // Offset the indices so the next transfers wrap the storage
+    const std::array<int, 5> first {0, 1, 2, 3, 4};
+    EXPECT_EQ(ring.Push(first), 5);
+    std::array<int, 5> out {};
+    EXPECT_EQ(ring.Pop(out), 5);
+
+    std::array<int, 10> values {};
+    std::iota(values.begin(), values.end(), 10);
+    EXPECT_EQ(ring.Push(values), 8);
+    EXPECT_EQ(ring.Push(values), 0);
+
+    std::array<int, 10> popped {};
+    EXPECT_EQ(ring.Pop(popped), 8);
+    for (std::size_t i {0}; i < 8; ++i) EXPECT_EQ(popped.at(i), values.at(i));
+    EXPECT_EQ(ring.Pop(popped), 0);
+}
+
+TEST(SpscRing, TransfersBetweenThreads) {
+    constexpr std::uint32_t          kCount {100'000};
+    StaticSpscRing<std::uint32_t, 64> ring {};
+
+    std::thread producer {[&] {
+        std::array<std::uint32_t, 16> chunk {};
+        std::uint32_t                 next {0};
+        while (next < kCount) {
+            std::iota(chunk.begin(), chunk.end(), next);
+            const auto size {
+                std::min<std::size_t>(chunk.size(), kCount - next)
+            };
+            next += ring.Push(std::span(chunk).first(size));
+        }
+    }};
+
+    std::vector<std::uint32_t> received {};
+    received.reserve(kCount);
+    while (received.size() < kCount)
+        if (auto value {ring.TryPop()}) received.push_back(*value);
+    producer.join();
+
+    for (std::uint32_t i {0}; i < kCount; ++i) ASSERT_EQ(received.at(i), i);
+}
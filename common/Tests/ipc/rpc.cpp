@@ -0,0 +1,147 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/rpc.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::AsyncValue;
+using obc::ipc::Procedure;
+using obc::ipc::RpcClient;
+using obc::ipc::RpcServer;
+using obc::ipc::RpcStatus;
+
+enum class Service : std::uint8_t { kAdd, kScale };
+
+struct Pair {
+    std::int32_t a;
+    std::int32_t b;
+};
+
+using TestProtocol = obc::ipc::Protocol<
+    Procedure<Service::kAdd, Pair, std::int32_t>,
+    Procedure<Service::kScale, float, double>>;
+using TestLink = obc::ipc::RpcLink<TestProtocol>;
+
+class Calculator {
+  public:
+    auto Add(const Pair& pair) -> std::int32_t { return pair.a + pair.b; }
+};
+
+/**
+ * @brief Runs a loop on its own thread, standing in for a task on one core.
+ */
+class Core {
+  public:
+    template<typename F>
+    explicit Core(F f)
+        : m_thread([this, f] mutable {
+              while (!m_stop) f();
+          }) {}
+
+    Core(const Core&)                    = delete;
+    Core(Core&&)                         = delete;
+    auto operator=(const Core&) -> Core& = delete;
+    auto operator=(Core&&) -> Core&      = delete;
+
+    ~Core() {
+        m_stop = true;
+        m_thread.join();
+    }
+
+  private:
+    std::atomic<bool> m_stop {false};
+    std::thread       m_thread;
+};
+}  // namespace
+
+TEST(Rpc, CallsHandlerOnOtherCore) {
+    TestLink link {};
+    link.Reset(1);
+
+    Calculator          calculator {};
+    RpcServer<TestLink> server {link};
+    RpcClient<TestLink> client {link};
+    server.Bind<Service::kAdd>(OBC_CALLBACK_METHOD(calculator, Add));
+
+    // Each side's task runs on a thread of its own
+    constexpr auto kPoll {obc::scheduling::Duration::Milliseconds(1)};
+    const Core     serving {[&] { server.Serve(kPoll); }};
+    const Core     servicing {[&] { client.Service(kPoll); }};
+
+    EXPECT_EQ(
+        client.Call<Service::kAdd>(Pair {2, 3}, units::seconds<float>(5)), 5
+    );
+
+    AsyncValue<std::expected<std::int32_t, RpcStatus>> sum {};
+    ASSERT_TRUE(
+        client.Call<Service::kAdd>(Pair {4, 5}, sum, units::seconds<float>(5))
+    );
+    EXPECT_EQ(sum.Wait(units::seconds<float>(5))->get(), 9);
+
+    // Nothing is bound to this procedure, which the caller learns at once
+    const auto start {std::chrono::steady_clock::now()};
+    EXPECT_EQ(
+        client.Call<Service::kScale>(1.0F, units::seconds<float>(5)),
+        std::nullopt
+    );
+    EXPECT_LT(
+        std::chrono::steady_clock::now() - start, std::chrono::seconds(1)
+    );
+
+    AsyncValue<std::expected<double, RpcStatus>> scaled {};
+    ASSERT_TRUE(
+        client.Call<Service::kScale>(1.0F, scaled, units::seconds<float>(5))
+    );
+    EXPECT_EQ(
+        scaled.Wait(units::seconds<float>(5))->get(),
+        std::unexpected {RpcStatus::kUnbound}
+    );
+    EXPECT_EQ(client.Stats().calls, 4);
+    EXPECT_EQ(client.Stats().failed, 2);
+}
+
+TEST(Rpc, LimitsAndTimesOutCallsInFlight) {
+    TestLink link {};
+    link.Reset(1);
+    RpcClient<TestLink, 2> client {link};
+
+    // With no server, calls stay in flight until they time out
+    std::array<AsyncValue<std::expected<std::int32_t, RpcStatus>>, 3>
+        results {};
+    for (auto& result : results) {
+        client.Call<Service::kAdd>(
+            Pair {}, result, units::milliseconds<float>(1)
+        );
+    }
+    EXPECT_EQ(client.Stats().calls, 2);
+    EXPECT_EQ(client.Stats().rejected, 1);
+
+    client.Service(units::milliseconds<float>(5));
+    EXPECT_EQ(client.Stats().timeouts, 2);
+}
@@ -0,0 +1,83 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/select.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::AsyncValue;
+using obc::ipc::WaitAll;
+using obc::ipc::WaitAny;
+using obc::scheduling::Timeout;
+
+/**
+ * @brief Sets a value from another thread after a delay.
+ */
+auto SetLater(AsyncValue<int>& value, int data, int delay_ms) -> std::thread {
+    return std::thread([&value, data, delay_ms] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        value.Set(data);
+    });
+}
+}  // namespace
+
+TEST(WaitAny, ReportsFirstReadySource) {
+    AsyncValue<int> slow {};
+    AsyncValue<int> fast {};
+    Timeout         timeout {units::seconds<float>(5)};
+    auto            setter {SetLater(fast, 1, 10)};
+
+    const auto start {std::chrono::steady_clock::now()};
+    EXPECT_EQ(WaitAny(slow, fast, timeout), 1);
+    EXPECT_LT(
+        std::chrono::steady_clock::now() - start, std::chrono::seconds(1)
+    );
+    setter.join();
+}
+
+TEST(WaitAny, ReportsTimeout) {
+    AsyncValue<int> never {};
+    Timeout         late {units::seconds<float>(5)};
+    Timeout         early {units::milliseconds<float>(10)};
+
+    EXPECT_EQ(WaitAny(never, late, early), 2);
+    EXPECT_TRUE(early);
+}
+
+TEST(WaitAll, WaitsForEveryValue) {
+    AsyncValue<int> first {};
+    AsyncValue<int> second {};
+    Timeout         timeout {units::seconds<float>(5)};
+    auto            first_setter {SetLater(first, 1, 5)};
+    auto            second_setter {SetLater(second, 2, 15)};
+
+    EXPECT_TRUE(WaitAll(first, second, timeout));
+    EXPECT_FALSE(timeout);
+    first_setter.join();
+    second_setter.join();
+
+    AsyncValue<int> never {};
+    Timeout         short_timeout {units::milliseconds<float>(10)};
+    EXPECT_FALSE(WaitAll(first, never, short_timeout));
+}
@@ -0,0 +1,107 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/ipc/topic.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::ipc::Broker;
+using obc::ipc::Delivery;
+using obc::ipc::TopicSpec;
+
+enum class TopicId : std::uint8_t { kAttitude, kEvents };
+
+struct Attitude {
+    float roll;
+    float pitch;
+};
+
+using AttitudeSpec = TopicSpec<TopicId::kAttitude, Attitude, Delivery::kLatest>;
+using EventSpec    = TopicSpec<TopicId::kEvents, int, Delivery::kQueued, 4>;
+}  // namespace
+
+TEST(Topic, SharesLatestSampleWithoutCopying) {
+    obc::ipc::Topic<AttitudeSpec> topic {};
+    auto                          first {*topic.Subscribe()};
+    auto                          second {*topic.Subscribe()};
+    EXPECT_EQ(first.Poll(), std::nullopt);
+
+    auto loan {*topic.Loan()};
+    loan->roll = 1.0F;
+    const auto* written {&*loan};
+    topic.Publish(std::move(loan));
+
+    const auto a {first.Poll()};
+    const auto b {second.Poll()};
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(&**a, written);
+    EXPECT_EQ(&**b, written);
+    EXPECT_EQ((*a)->roll, 1.0F);
+
+    // Each sample is returned once
+    EXPECT_EQ(first.Poll(), std::nullopt);
+    topic.Publish(Attitude {.roll = 2.0F, .pitch = 0.0F});
+    EXPECT_EQ((*first.Poll())->roll, 2.0F);
+    EXPECT_EQ(topic.Stats().published, 2);
+}
+
+TEST(Topic, CountsDropsWhenQueueOrPoolIsFull) {
+    obc::ipc::Topic<EventSpec> topic {};
+    auto                       sub {*topic.Subscribe()};
+
+    // The queue holds 4 and the pool 4, so later samples are dropped
+    for (int i {0}; i < 6; ++i) topic.Publish(i);
+    EXPECT_EQ(topic.Stats().published, 4);
+    EXPECT_EQ(topic.Stats().dropped, 2);
+
+    std::vector<int> received {};
+    while (auto sample {sub.Poll()}) received.push_back(**sample);
+    EXPECT_EQ(received, (std::vector {0, 1, 2, 3}));
+
+    // Every buffer returned to the pool with its last reference
+    for (int i {0}; i < 4; ++i) EXPECT_TRUE(topic.Publish(i));
+}
+
+TEST(Topic, BlockingPopWakesOnPublish) {
+    Broker<AttitudeSpec, EventSpec> broker {};
+    auto& events {broker.Get<TopicId::kEvents>()};
+    auto  sub {*events.Subscribe()};
+
+    std::thread publisher {[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        events.Publish(7);
+    }};
+    const auto sample {sub.Pop(units::seconds<float>(5))};
+    ASSERT_TRUE(sample);
+    EXPECT_EQ(**sample, 7);
+    publisher.join();
+
+    std::uint32_t published {0};
+    broker.VisitStats([&](TopicId, obc::ipc::TopicStats stats) {
+        published += stats.published;
+    });
+    EXPECT_EQ(published, 1);
+}
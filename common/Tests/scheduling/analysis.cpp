@@ -0,0 +1,77 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/analysis.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::Analyse;
+using obc::scheduling::TaskSet;
+using obc::scheduling::TaskSpec;
+
+namespace {
+// Classic example which is schedulable with no slack for the lowest priority
+constexpr std::array<TaskSpec, 3> kTight {
+    TaskSpec {.period = 20, .budget = 5},
+    TaskSpec {.period = 7, .budget = 3},
+    TaskSpec {.period = 12, .budget = 3},
+};
+
+using TightSet = TaskSet<kTight.at(0), kTight.at(1), kTight.at(2)>;
+static_assert(TightSet::kAnalysis.Schedulable());
+}  // namespace
+
+TEST(TaskSetAnalysis, AssignsRateMonotonicPriorities) {
+    constexpr auto kAnalysis {Analyse(kTight)};
+    EXPECT_EQ(kAnalysis.ranks.at(0), 2);
+    EXPECT_EQ(kAnalysis.ranks.at(1), 0);
+    EXPECT_EQ(kAnalysis.ranks.at(2), 1);
+}
+
+TEST(TaskSetAnalysis, FindsWorstCaseResponseTimes) {
+    constexpr auto kAnalysis {Analyse(kTight)};
+    EXPECT_EQ(kAnalysis.response_times.at(0), 20);
+    EXPECT_EQ(kAnalysis.response_times.at(1), 3);
+    EXPECT_EQ(kAnalysis.response_times.at(2), 6);
+}
+
+TEST(TaskSetAnalysis, RejectsMissedDeadlines) {
+    // Under full utilization, but the longest task is preempted too often
+    constexpr auto kAnalysis {Analyse(std::array {
+        TaskSpec {.period = 20, .budget = 6},
+        TaskSpec {.period = 7, .budget = 3},
+        TaskSpec {.period = 12, .budget = 3},
+    })};
+    EXPECT_LT(kAnalysis.utilization, 1'000'000);
+    EXPECT_FALSE(kAnalysis.response_times.at(0));
+    EXPECT_FALSE(kAnalysis.Schedulable());
+}
+
+TEST(TaskSetAnalysis, HonoursConstrainedDeadlines) {
+    constexpr auto kAnalysis {Analyse(std::array {
+        TaskSpec {.period = 10, .budget = 2},
+        TaskSpec {.period = 50, .budget = 1, .deadline = 5},
+    })};
+    EXPECT_EQ(kAnalysis.ranks.at(1), 0);
+    EXPECT_EQ(kAnalysis.response_times.at(0), 3);
+    EXPECT_TRUE(kAnalysis.Schedulable());
+}
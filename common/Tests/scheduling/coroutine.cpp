@@ -0,0 +1,150 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/coroutine.hpp>
+#include <obc/scheduling/simulation.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::Clock;
+using obc::scheduling::Coroutine;
+using obc::scheduling::CoroutineExecutor;
+using obc::scheduling::Duration;
+using obc::scheduling::Executor;
+using obc::scheduling::PollAwaiter;
+using obc::scheduling::Simulation;
+using obc::scheduling::Timeout;
+
+namespace {
+constexpr std::size_t    kFrameSize {256};
+constexpr Clock::Instant kMillisecond {1'000};
+
+/**
+ * @brief Executor polled by the test rather than by a task.
+ */
+template<std::size_t Frames>
+class ManualExecutor
+    : private obc::scheduling::internal::FrameStorage<Frames * kFrameSize>,
+      public Executor {
+  public:
+    ManualExecutor() : Executor(this->frames, kFrameSize) {}
+
+    auto Wake() -> void override { ++wakes; }
+
+    using Executor::Poll;
+
+    int wakes {0};
+};
+
+auto Count(Executor& /*executor*/, int& count) -> Coroutine {
+    ++count;
+    co_return;
+}
+
+auto Oversized(Executor& /*executor*/, int& count) -> Coroutine {
+    std::array<std::byte, 2 * kFrameSize> scratch {};
+    co_await Timeout(Duration::Microseconds(0));
+    count += static_cast<int>(scratch.size());
+}
+
+auto Receive(
+    Executor& /*executor*/, std::optional<int>& source, std::optional<int>& out
+) -> Coroutine {
+    auto poll {[&] { return std::exchange(source, std::nullopt); }};
+    out = co_await PollAwaiter(poll);
+}
+
+auto Sleep(
+    Executor& /*executor*/, Duration duration,
+    std::optional<Clock::Instant>& woke
+) -> Coroutine {
+    co_await Timeout(duration);
+    woke = Clock::Now();
+}
+}  // namespace
+
+TEST(Coroutine, StartsWhenExecutorRuns) {
+    ManualExecutor<2> executor {};
+    int               count {0};
+
+    EXPECT_TRUE(Count(executor, count));
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(executor.FramesInUse(), 1);
+    EXPECT_EQ(executor.wakes, 1);
+
+    executor.Poll();
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+}
+
+TEST(Coroutine, FailsToSpawnWhenPoolIsExhausted) {
+    ManualExecutor<2> executor {};
+    int               count {0};
+
+    EXPECT_TRUE(Count(executor, count));
+    EXPECT_TRUE(Count(executor, count));
+    EXPECT_FALSE(Count(executor, count));
+    EXPECT_FALSE(Oversized(executor, count));
+    EXPECT_EQ(executor.AllocationFailures(), 2);
+
+    // Completed coroutines return their frames to the pool
+    executor.Poll();
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+    EXPECT_TRUE(Count(executor, count));
+}
+
+TEST(Coroutine, ResumesOncePollableIsReady) {
+    ManualExecutor<1>  executor {};
+    std::optional<int> source {};
+    std::optional<int> out {};
+
+    ASSERT_TRUE(Receive(executor, source, out));
+    executor.Poll();
+    executor.Poll();
+    EXPECT_FALSE(out);
+
+    source = 5;
+    executor.Poll();
+    EXPECT_EQ(out, 5);
+    EXPECT_FALSE(source);
+    EXPECT_EQ(executor.FramesInUse(), 0);
+}
+
+TEST(Coroutine, ResumesAfterTimeout) {
+    Simulation                    sim {};
+    CoroutineExecutor<2>          executor {};
+    std::optional<Clock::Instant> woke {};
+
+    ASSERT_TRUE(Sleep(executor, Duration::Milliseconds(5), woke));
+    sim.RunUntil(4 * kMillisecond);
+    EXPECT_FALSE(woke);
+
+    // The timeout is only checked each time the executor runs
+    sim.RunUntil(20 * kMillisecond);
+    ASSERT_TRUE(woke);
+    EXPECT_GE(*woke, 5 * kMillisecond);
+    EXPECT_LE(*woke, 6 * kMillisecond);
+}
@@ -0,0 +1,136 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/delay.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+using obc::scheduling::Clock;
+using obc::scheduling::Duration;
+using obc::scheduling::Notification;
+using obc::scheduling::Timeout;
+namespace wait = obc::scheduling::wait;
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr units::microseconds<float> kPeriod {2000};
+constexpr std::chrono::microseconds  kChronoPeriod {2000};
+
+// Conversions from units happen at compile time
+static_assert(Duration(kPeriod).Count() == 2000);
+static_assert(Duration(units::milliseconds<float>(0.1F)).Count() == 100);
+static_assert(Duration(units::seconds<double>(-1)).Offset() == 0);
+static_assert(Duration::Milliseconds(3) - Duration(kPeriod) < kPeriod);
+static_assert(Clock::Instant {5} + Duration::Microseconds(10) == 15);
+}  // namespace
+
+TEST(Timeout, ElapsesAfterPeriod) {
+    const auto start {SteadyClock::now()};
+    Timeout    timeout {kPeriod};
+    EXPECT_FALSE(timeout);
+
+    timeout.Block();
+    EXPECT_TRUE(timeout);
+    EXPECT_GE(SteadyClock::now() - start, kChronoPeriod);
+}
+
+TEST(Timeout, UntilPastDeadlineHasElapsed) {
+    EXPECT_TRUE(Timeout::Until(Clock::Now()));
+    EXPECT_FALSE(Timeout::Until(Clock::Now() + 1'000'000));
+}
+
+TEST(Timeout, PollReturnsResult) {
+    int  calls {0};
+    auto result {Timeout(kPeriod).Poll([&] -> std::optional<int> {
+        if (++calls < 3) return std::nullopt;
+        return calls;
+    })};
+    EXPECT_EQ(result, 3);
+}
+
+TEST(Timeout, PollGivesUpAtDeadline) {
+    const auto start {SteadyClock::now()};
+    EXPECT_FALSE(Timeout(kPeriod).Poll([] { return false; }));
+    EXPECT_GE(SteadyClock::now() - start, kChronoPeriod);
+}
+
+TEST(Timeout, PollRecordsAttempts) {
+    const auto before {wait::Spin::Stats().Read()};
+    int        calls {0};
+    EXPECT_TRUE(
+        Timeout(kPeriod).Poll([&] { return ++calls == 3; }, wait::Spin {})
+    );
+
+    const auto after {wait::Spin::Stats().Read()};
+    EXPECT_EQ(after.calls - before.calls, 1);
+    EXPECT_EQ(after.timeouts, before.timeouts);
+    EXPECT_EQ(after.polls - before.polls, 3);
+}
+
+TEST(Timeout, BackoffGivesBackCpuTime) {
+    constexpr units::microseconds<float> kLongPeriod {20'000};
+
+    const auto before {wait::Backoff::Stats().Read()};
+    const auto start {SteadyClock::now()};
+    EXPECT_FALSE(
+        Timeout(kLongPeriod).Poll([] { return false; }, wait::Backoff {})
+    );
+    const auto elapsed {SteadyClock::now() - start};
+
+    const auto after {wait::Backoff::Stats().Read()};
+    EXPECT_EQ(after.timeouts - before.timeouts, 1);
+    // 100us doubling up to 10ms covers 20ms in 9 sleeps
+    EXPECT_LE(after.polls - before.polls, 12);
+    const std::chrono::duration<float, std::micro> wall {elapsed};
+    EXPECT_LT(after.cpu.value() - before.cpu.value(), wall.count() / 2);
+}
+
+TEST(Timeout, NotifyWakesOnGive) {
+    constexpr units::microseconds<float> kLongPeriod {1'000'000};
+
+    const auto        before {wait::Notify::Stats().Read()};
+    auto              self {Notification::Current()};
+    std::atomic<bool> ready {false};
+    std::jthread      giver {[&] {
+        std::this_thread::sleep_for(kChronoPeriod);
+        ready = true;
+        self.Give();
+    }};
+
+    const auto start {SteadyClock::now()};
+    EXPECT_TRUE(Timeout(kLongPeriod).Poll(
+        [&] { return ready.load(); }, wait::Notify {}
+    ));
+    EXPECT_LT(SteadyClock::now() - start, std::chrono::milliseconds(500));
+
+    const auto after {wait::Notify::Stats().Read()};
+    EXPECT_EQ(after.polls - before.polls, 2);
+}
+
+TEST(TimeoutGuard, DelaysUntilEndOfScope) {
+    const auto start {SteadyClock::now()};
+    { Timeout::Guard guard {kPeriod}; }
+    EXPECT_GE(SteadyClock::now() - start, kChronoPeriod);
+}
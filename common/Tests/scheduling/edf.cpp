@@ -0,0 +1,126 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/delay.hpp>
+#include <obc/scheduling/edf.hpp>
+#include <obc/scheduling/simulation.hpp>
+#include <obc/scheduling/task.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::Clock;
+using obc::scheduling::EdfSupervisor;
+using obc::scheduling::Simulation;
+using obc::scheduling::StackTask;
+using obc::scheduling::Timeout;
+using obc::scheduling::WakeReason;
+
+namespace {
+constexpr Clock::Instant kMillisecond {1'000};
+
+using Log = std::vector<std::pair<Clock::Instant, int>>;
+
+/**
+ * @brief Records the time of each of its runs, then stays busy for a while.
+ */
+class Job : public StackTask<256> {
+  public:
+    Job(Log& log, int id, units::milliseconds<float> period,
+        osPriority priority, units::milliseconds<float> busy = {})
+        : StackTask("Job", period, priority), m_log(log), m_id(id),
+          m_busy(busy) {}
+
+    ~Job() override = default;
+
+    Job(const Job&)                    = delete;
+    Job(Job&&)                         = delete;
+    auto operator=(const Job&) -> Job& = delete;
+    auto operator=(Job&&) -> Job&      = delete;
+
+  protected:
+    auto Run(WakeReason /*reason*/) -> void override {
+        m_log.emplace_back(Clock::Now(), m_id);
+        if (m_busy.value() > 0) Timeout(m_busy).Block();
+    }
+
+  private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Log&                       m_log;
+    int                        m_id;
+    units::milliseconds<float> m_busy;
+};
+}  // namespace
+
+TEST(EdfSupervisor, RunsEarliestDeadlineFirst) {
+    Log           log {};
+    Simulation    sim {};
+    EdfSupervisor edf {osPriorityNormal};
+    // Rate-monotonic priorities, which EDF overrides
+    Job fast(log, 0, units::milliseconds<float>(10), osPriorityHigh);
+    Job slow(log, 1, units::milliseconds<float>(30), osPriorityLow);
+    ASSERT_TRUE(edf.Add(fast, units::milliseconds<float>(10)));
+    ASSERT_TRUE(edf.Add(slow, units::milliseconds<float>(5)));
+    EXPECT_GT(edf.Priority(slow), edf.Priority(fast));
+
+    sim.RunUntil(30 * kMillisecond);
+    const Log expected {
+        {0,                 1},
+        {0,                 0},
+        {10 * kMillisecond, 0},
+        {20 * kMillisecond, 0},
+        // Due at 35ms, before the fast task's job due at 40ms
+        {30 * kMillisecond, 1},
+        {30 * kMillisecond, 0},
+    };
+    EXPECT_EQ(log, expected);
+    EXPECT_EQ(edf.Priority(fast), osPriorityNormal + 1);
+    EXPECT_EQ(edf.Misses(), 0);
+}
+
+TEST(EdfSupervisor, RejectsBandAbovePriorities) {
+    Log           log {};
+    Simulation    sim {};
+    EdfSupervisor edf {osPriorityRealtime};
+    Job           job(log, 0, units::milliseconds<float>(10), osPriorityNormal);
+
+    EXPECT_FALSE(edf.Add(job, units::milliseconds<float>(10)));
+    EXPECT_EQ(edf.Priority(job), osPriorityNone);
+}
+
+TEST(EdfSupervisor, CountsDeadlineMisses) {
+    Log           log {};
+    Simulation    sim {};
+    EdfSupervisor edf {};
+    Job           late(
+        log, 0, units::milliseconds<float>(10), osPriorityNormal,
+        units::milliseconds<float>(6)
+    );
+    Job on_time(log, 1, units::milliseconds<float>(10), osPriorityNormal);
+    edf.Add(late, units::milliseconds<float>(5));
+    edf.Add(on_time, units::milliseconds<float>(10));
+
+    sim.RunUntil(50 * kMillisecond);
+    EXPECT_EQ(edf.Misses(late), 5);
+    EXPECT_EQ(edf.Misses(on_time), 0);
+    EXPECT_EQ(edf.Misses(), 5);
+}
@@ -0,0 +1,238 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/delay.hpp>
+#include <obc/scheduling/simulation.hpp>
+#include <obc/scheduling/task.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::Clock;
+using obc::scheduling::Simulation;
+using obc::scheduling::StackTask;
+using obc::scheduling::Timeout;
+using obc::scheduling::WakeReason;
+
+namespace {
+constexpr Clock::Instant kMillisecond {1'000};
+constexpr Clock::Instant kSecond {1'000'000};
+
+using Log = std::vector<std::pair<Clock::Instant, int>>;
+
+static_assert(obc::scheduling::RecommendStackDepth(0) == 128);
+static_assert(obc::scheduling::RecommendStackDepth(1000) == 1256);
+
+/**
+ * @brief Records the time of each of its runs.
+ */
+class Recorder : public StackTask<256> {
+  public:
+    Recorder(
+        Log& log, int id, units::milliseconds<float> period,
+        osPriority priority = osPriorityNormal
+    )
+        : StackTask("Recorder", period, priority), m_log(log), m_id(id) {}
+
+    ~Recorder() override = default;
+
+    Recorder(const Recorder&)                    = delete;
+    Recorder(Recorder&&)                         = delete;
+    auto operator=(const Recorder&) -> Recorder& = delete;
+    auto operator=(Recorder&&) -> Recorder&      = delete;
+
+    /// Task to notify on every run, if any.
+    obc::scheduling::Task* notify {nullptr};
+    /// Time spent busy in each run.
+    units::microseconds<float> busy {0};
+    /// Real CPU time burnt in each run, which takes no virtual time.
+    std::chrono::microseconds  spin {0};
+    int events {0};
+
+  protected:
+    auto Run(WakeReason reason) -> void override {
+        m_log.emplace_back(Clock::Now(), m_id);
+        if (reason == WakeReason::kEvent) ++events;
+        if (busy.value() > 0) Timeout(busy).Block();
+        for (const auto start {std::chrono::steady_clock::now()};
+             std::chrono::steady_clock::now() - start < spin;) {}
+        if (notify) notify->Notify();
+    }
+
+  private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Log& m_log;
+    int  m_id;
+};
+
+/**
+ * @brief Holds a guard for longer than its period, so spends most of its time
+ * waiting in the guard's destructor.
+ */
+class Overrunner : public StackTask<256> {
+  public:
+    Overrunner() : StackTask("Overrunner", units::milliseconds<float>(10)) {}
+
+    int runs {0};
+
+  protected:
+    auto Run(WakeReason /*reason*/) -> void override {
+        ++runs;
+        const Timeout::Guard guard {units::milliseconds<float>(500)};
+    }
+};
+
+auto FlightTrace(Clock::Instant duration) -> Log {
+    Log        log {};
+    Simulation sim {};
+    Recorder   telemetry(log, 0, units::milliseconds<float>(100));
+    Recorder   can(log, 1, units::milliseconds<float>(250), osPriorityHigh);
+    Recorder   logging(log, 2, units::milliseconds<float>(1000));
+
+    telemetry.busy = units::microseconds<float>(1500);
+    can.notify     = &logging;
+
+    sim.RunUntil(duration);
+    return log;
+}
+}  // namespace
+
+TEST(Simulation, RunsPeriodicTasksOnVirtualTime) {
+    Log        log {};
+    Simulation sim {};
+    Recorder   task(log, 0, units::milliseconds<float>(10));
+
+    sim.RunUntil(kSecond);
+    EXPECT_EQ(Clock::Now(), kSecond);
+    ASSERT_EQ(log.size(), 101);
+    for (std::size_t i {0}; i < log.size(); ++i)
+        EXPECT_EQ(log.at(i).first, i * 10 * kMillisecond);
+}
+
+TEST(Simulation, RunsSimultaneousReleasesByPriority) {
+    Log        log {};
+    Simulation sim {};
+    Recorder   low(log, 0, units::milliseconds<float>(10), osPriorityLow);
+    Recorder   high(log, 1, units::milliseconds<float>(10), osPriorityHigh);
+
+    sim.RunUntil(20 * kMillisecond);
+    ASSERT_EQ(log.size(), 6);
+    for (std::size_t i {0}; i < log.size(); i += 2) {
+        EXPECT_EQ(log.at(i).second, 1);
+        EXPECT_EQ(log.at(i + 1).second, 0);
+    }
+}
+
+TEST(Simulation, WakesNotifiedTasks) {
+    Log        log {};
+    Simulation sim {};
+    Recorder   slow(log, 0, units::milliseconds<float>(1000));
+    Recorder   fast(log, 1, units::milliseconds<float>(30), osPriorityHigh);
+    fast.notify = &slow;
+
+    sim.RunUntil(100 * kMillisecond);
+    EXPECT_EQ(slow.events, 4);
+    EXPECT_EQ(log.back(), std::pair(90 * kMillisecond, 0));
+}
+
+TEST(Simulation, DriverWaitsInVirtualTime) {
+    Simulation sim {};
+    Timeout(units::milliseconds<float>(5)).Block();
+    EXPECT_EQ(Clock::Now(), 5 * kMillisecond);
+
+    // A value set by a task is seen at exactly the time it is set
+    Log      log {};
+    Recorder task(log, 0, units::milliseconds<float>(300));
+
+    const auto value {Timeout(units::milliseconds<float>(1000)).Poll([&] {
+        return log.size() > 1 ? std::optional(log.back().first) : std::nullopt;
+    })};
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, 305 * kMillisecond);
+    EXPECT_EQ(Clock::Now(), 305 * kMillisecond);
+}
+
+TEST(Simulation, MeasuresTaskCpuUsage) {
+    Log        log {};
+    Simulation sim {};
+    Recorder   idle(log, 0, units::milliseconds<float>(10));
+    Recorder   busy(log, 1, units::milliseconds<float>(10));
+    busy.spin = std::chrono::milliseconds(1);
+
+    sim.RunUntil(190 * kMillisecond);
+    const auto usage {busy.Usage()};
+    // Allow for the host preempting the spinning thread
+    EXPECT_GE(usage.cpu_time.value(), 10'000);
+    EXPECT_LT(idle.Usage().cpu_time.value(), usage.cpu_time.value() / 2);
+    EXPECT_GE(usage.context_switches, 20);
+
+    const auto load {obc::scheduling::Task::Load()};
+    EXPECT_GE(load.IdlePercent(), 0);
+    EXPECT_LE(load.IdlePercent(), 100);
+}
+
+TEST(Simulation, ReportsStackUsage) {
+    Log        log {};
+    Simulation sim {};
+    Recorder   first(log, 0, units::milliseconds<float>(10));
+    Recorder   second(log, 1, units::milliseconds<float>(10));
+
+    sim.RunUntil(50 * kMillisecond);
+    std::array<obc::scheduling::StackUsage, 4> usages {};
+    ASSERT_EQ(obc::scheduling::Task::StackReport(usages), 2);
+
+    EXPECT_STREQ(usages.at(0).name, "Recorder");
+    EXPECT_EQ(usages.at(0).depth, 256);
+    EXPECT_GT(usages.at(0).peak, 0);
+    EXPECT_EQ(
+        usages.at(1).recommended,
+        obc::scheduling::RecommendStackDepth(usages.at(1).peak)
+    );
+}
+
+TEST(Simulation, StopsTaskWaitingInDestructor) {
+    Simulation sim {};
+    {
+        Overrunner task {};
+        sim.RunUntil(100 * kMillisecond);
+        EXPECT_EQ(task.runs, 1);
+    }
+
+    // The stopped task did not advance time while finishing its run
+    EXPECT_EQ(Clock::Now(), 100 * kMillisecond);
+    sim.RunUntil(200 * kMillisecond);
+    EXPECT_EQ(Clock::Now(), 200 * kMillisecond);
+}
+
+TEST(Simulation, FlightIsReproducible) {
+    constexpr Clock::Instant kHour {60 * 60 * kSecond};
+
+    const auto first {FlightTrace(kHour)};
+    const auto second {FlightTrace(kHour)};
+    // Each CAN run also wakes the logging task
+    EXPECT_EQ(first.size(), 36'001 + 14'401 * 2 + 3'601);
+    EXPECT_EQ(first, second);
+}
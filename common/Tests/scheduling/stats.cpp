@@ -0,0 +1,68 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/stats.hpp>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::ExecutionStats;
+
+TEST(ExecutionStats, StartsEmpty) {
+    const auto stats {ExecutionStats().Read()};
+    EXPECT_EQ(stats.runs, 0);
+    EXPECT_EQ(stats.overruns, 0);
+    EXPECT_EQ(stats.mean.value(), 0);
+}
+
+TEST(ExecutionStats, TracksExecutionTimes) {
+    ExecutionStats stats {};
+    stats.Record(30, 40, false);
+    stats.Record(10, 20, false);
+    stats.Record(50, 120, true);
+
+    const auto snapshot {stats.Read()};
+    EXPECT_EQ(snapshot.runs, 3);
+    EXPECT_EQ(snapshot.overruns, 1);
+    EXPECT_FLOAT_EQ(snapshot.best.value(), 10);
+    EXPECT_FLOAT_EQ(snapshot.worst.value(), 50);
+    EXPECT_FLOAT_EQ(snapshot.mean.value(), 30);
+}
+
+TEST(ExecutionStats, BucketsResponseTimes) {
+    ExecutionStats stats {};
+    stats.Record(0, 0, false);
+    stats.Record(0, 1, false);
+    stats.Record(0, 3, false);
+    stats.Record(0, 1'000'000'000, false);
+
+    const auto histogram {stats.Read().histogram};
+    EXPECT_EQ(histogram.at(0), 1);
+    EXPECT_EQ(histogram.at(1), 1);
+    EXPECT_EQ(histogram.at(2), 1);
+    EXPECT_EQ(histogram.back(), 1);
+}
+
+TEST(ExecutionStats, Reset) {
+    ExecutionStats stats {};
+    stats.Record(10, 10, true);
+    stats.Reset();
+    EXPECT_EQ(stats.Read().runs, 0);
+    EXPECT_EQ(stats.Read().histogram.at(4), 0);
+}
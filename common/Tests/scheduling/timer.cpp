@@ -0,0 +1,162 @@
+/* USER CODE BEGIN Header */
+/*
+ * 401 Ballon OBC
+ * Copyright (C) 2024 Bluesat and contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+/* USER CODE END Header */
+
+#include <obc/scheduling/timer.hpp>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using obc::scheduling::Clock;
+using obc::scheduling::Timer;
+using obc::scheduling::TimerWheel;
+
+namespace {
+struct Probe {
+    Clock::Instant* now {nullptr};
+    Clock::Instant  fired_at {0};
+    int             count {0};
+
+    auto Fire() -> void {
+        fired_at = *now;
+        ++count;
+    }
+};
+}  // namespace
+
+TEST(TimerWheel, OneShotFiresOnce) {
+    TimerWheel     wheel(1000);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    auto timer {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 5000)};
+    EXPECT_TRUE(timer.Active());
+    EXPECT_EQ(wheel.Advance(4999), 0);
+    EXPECT_EQ(wheel.Advance(5000), 1);
+    EXPECT_EQ(wheel.Advance(100'000), 0);
+    EXPECT_EQ(probe.count, 1);
+    EXPECT_FALSE(timer.Active());
+}
+
+TEST(TimerWheel, RoundsUpToTick) {
+    TimerWheel     wheel(1000);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    auto timer {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 1500)};
+    EXPECT_EQ(wheel.Advance(1999), 0);
+    EXPECT_EQ(wheel.Advance(2000), 1);
+}
+
+TEST(TimerWheel, CancelsWhenHandleDestroyed) {
+    TimerWheel     wheel(1);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    { auto timer {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 10)}; }
+    auto kept {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 20)};
+    kept.Cancel();
+
+    EXPECT_EQ(wheel.Advance(1000), 0);
+    EXPECT_FALSE(wheel.NextExpiry());
+}
+
+TEST(TimerWheel, MovedHandleKeepsTimer) {
+    TimerWheel     wheel(1);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    Timer outer {};
+    {
+        auto inner {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 10)};
+        outer = std::move(inner);
+    }
+
+    EXPECT_TRUE(outer.Active());
+    EXPECT_EQ(wheel.Advance(10), 1);
+}
+
+TEST(TimerWheel, PeriodicSkipsMissedFirings) {
+    TimerWheel     wheel(1);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    auto timer {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 100, 100)};
+    for (now = 0; now <= 1000; now += 50) wheel.Advance(now);
+    EXPECT_EQ(probe.count, 10);
+
+    // Falling far behind fires once and resumes on the original phase
+    now = 10'050;
+    EXPECT_EQ(wheel.Advance(now), 1);
+    EXPECT_EQ(wheel.NextExpiry(), 10'100);
+}
+
+TEST(TimerWheel, NextExpiryNeverLate) {
+    TimerWheel     wheel(1);
+    Clock::Instant now {0};
+    Probe          probe {&now};
+
+    auto soon {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 40)};
+    EXPECT_EQ(wheel.NextExpiry(), 40);
+
+    soon.Cancel();
+    auto later {wheel.Start(OBC_CALLBACK_METHOD(probe, Fire), 100'000)};
+    ASSERT_TRUE(wheel.NextExpiry());
+    EXPECT_LE(*wheel.NextExpiry(), 100'000);
+}
+
+TEST(TimerWheel, FiresDistantTimersOnTime) {
+    constexpr std::size_t kTimers {2000};
+
+    TimerWheel                          wheel(1);
+    Clock::Instant                      now {0};
+    std::array<Probe, kTimers>          probes {};
+    std::vector<Timer>                  timers {};
+    std::array<Clock::Instant, kTimers> expiries {};
+    std::mt19937_64                     rng(401);
+
+    timers.reserve(kTimers);
+    for (std::size_t i {0}; i < kTimers; ++i) {
+        // Spread over every level, including beyond the span of the wheel
+        const auto bits {rng() % 30};
+        expiries.at(i)   = (rng() & ((std::uint64_t {1} << bits) - 1)) + 1;
+        probes.at(i).now = &now;
+        timers.push_back(wheel.Start(
+            OBC_CALLBACK_METHOD(probes.at(i), Fire), expiries.at(i)
+        ));
+    }
+
+    // Advance by following the wheel's own wake-up times, with some jitter
+    while (const auto next {wheel.NextExpiry()}) {
+        ASSERT_GE(*next, now);
+        now = *next + rng() % 3;
+        wheel.Advance(now);
+    }
+
+    for (std::size_t i {0}; i < kTimers; ++i) {
+        EXPECT_EQ(probes.at(i).count, 1);
+        EXPECT_GE(probes.at(i).fired_at, expiries.at(i));
+        EXPECT_LE(probes.at(i).fired_at, expiries.at(i) + 2);
+    }
+}
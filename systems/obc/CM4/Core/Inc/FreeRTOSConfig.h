@@ -165,6 +165,29 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Per-task CPU accounting, see obc/sys/stm32/task.hpp */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS  1
+#define INCLUDE_xTaskGetIdleTaskHandle           1
+/* Blocking waits take their own notification, see obc/sys/stm32/delay.hpp */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    2
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #ifdef __cplusplus
+  extern "C" {
+  #endif
+  void obc_task_switched_out(void);
+  void obc_task_switched_in(void);
+  void obc_pre_sleep(uint32_t* expected);
+  void obc_post_sleep(uint32_t expected);
+  #ifdef __cplusplus
+  }
+  #endif
+#endif
+#define traceTASK_SWITCHED_OUT()                 obc_task_switched_out()
+#define traceTASK_SWITCHED_IN()                  obc_task_switched_in()
+/* Tickless idle, the tick is stopped while every task is blocked */
+#define configUSE_TICKLESS_IDLE                  1
+#define configPRE_SLEEP_PROCESSING(x)            obc_pre_sleep(&(x))
+#define configPOST_SLEEP_PROCESSING(x)           obc_post_sleep(x)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -184,4 +184,13 @@ void SysTick_Handler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles HSEM2 global interrupt, raised when the other
+  * core rings an obc::ipc::Doorbell.
+  */
+void HSEM2_IRQHandler(void)
+{
+  HAL_HSEM_IRQHandler();
+}
+
 /* USER CODE END 1 */